@@ -129,6 +129,9 @@ namespace Features
 		glBindVertexArray(vertex_array);
 		glDrawArrays(GL_TRIANGLES, 0, 3);
 
+		// Keep animating when power saving mode is enabled
+		ImFrame::RequestRedraw();
+
 	}
 
 }
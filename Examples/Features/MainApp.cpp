@@ -35,6 +35,9 @@ MainApp::MainApp(GLFWwindow * window) :
 	m_showGlDemo = ImFrame::GetConfigValue("show", "gldemo", m_showGlDemo);
 	m_showImGuiDemo = ImFrame::GetConfigValue("show", "imguidemo", m_showImGuiDemo);
 	m_showImPlotDemo = ImFrame::GetConfigValue("show", "implotdemo", m_showImPlotDemo);
+	m_powerSaving = ImFrame::GetConfigValue("settings", "powersaving", m_powerSaving);
+	ImFrame::EnablePowerSaving(m_powerSaving);
+	ImFrame::RegisterFont(ImFrame::FontType::RobotoMedium, 24.0f);
 }
 
 MainApp::~MainApp()
@@ -44,9 +47,7 @@ MainApp::~MainApp()
 	ImFrame::SetConfigValue("show", "gldemo", m_showGlDemo);
 	ImFrame::SetConfigValue("show", "imguidemo", m_showImGuiDemo);
 	ImFrame::SetConfigValue("show", "implotdemo", m_showImPlotDemo);
-	if (m_texture.textureID)
-		glDeleteTextures(1, &m_texture.textureID);
-
+	ImFrame::SetConfigValue("settings", "powersaving", m_powerSaving);
 }
 
 void MainApp::OnKeyPress(int key, int mods)
@@ -111,9 +112,15 @@ void MainApp::OnUpdate()
             ImFrame::MenuItem("Show OpenGL Demo", nullptr, &m_showGlDemo);
             ImFrame::MenuItem("Show ImGui Demo", nullptr, &m_showImGuiDemo);
             ImFrame::MenuItem("Show ImPlot Demo", nullptr, &m_showImPlotDemo);
+            bool showFrameStats = ImFrame::IsFrameStatsOverlayVisible();
+            if (ImFrame::MenuItem("Show Frame Statistics", "F12", &showFrameStats))
+                ImFrame::ShowFrameStatsOverlay(showFrameStats);
             ImFrame::Separator();
             ImFrame::MenuItem("Set Background Color...", nullptr, &m_setBgColor);
             ImFrame::MenuItem("Set UI Font...", nullptr, &m_setUiFont);
+            ImFrame::Separator();
+            if (ImFrame::MenuItem("Power Saving Mode", nullptr, &m_powerSaving))
+                ImFrame::EnablePowerSaving(m_powerSaving);
             ImFrame::EndMenu();
 		}
         if (m_showExtraMenu && ImFrame::BeginMenu("Extra"))
@@ -155,6 +162,8 @@ void MainApp::OnUpdate()
         ImFrame::EndMainMenuBar();
 	}
 
+	// The OpenGL demo renders directly with GL, so ImGui needs to preserve GL state around it
+	ImFrame::EnableRawGL(m_showGlDemo);
 	if (m_showGlDemo)
 		ShowGlDemo(GetWindow());
 	if (m_showImGuiDemo)
@@ -165,13 +174,16 @@ void MainApp::OnUpdate()
 		SetBgColor(&m_setBgColor);
 	if (m_setUiFont)
 		SetUiFont(&m_setUiFont);
-	if (m_showTexture)
+	if (m_showTexture && m_texture)
 	{
 		if (ImGui::Begin("OpenGL Texture Test", &m_showTexture, ImGuiWindowFlags_HorizontalScrollbar))
 		{
-			ImGui::Text("textureID = %i", m_texture.textureID);
-			ImGui::Text("size = %d x %d", m_texture.width, m_texture.height);
-			ImGui::Image((void *)(intptr_t)m_texture.textureID, ImVec2((float)m_texture.width, (float)m_texture.height));
+			auto texture = ImFrame::UseCachedTexture(m_texture);
+			ImGui::Text("textureID = %i", texture.textureID);
+			ImGui::Text("size = %d x %d", texture.width, texture.height);
+			if (ImFrame::GetCachedTextureState(m_texture) == ImFrame::LoadState::Failed)
+				ImGui::Text("Failed to load image");
+			ImGui::Image((void *)(intptr_t)texture.textureID, ImVec2((float)texture.width, (float)texture.height));
 		}
 		ImGui::End();
 	}
@@ -201,14 +213,8 @@ void MainApp::Open()
 	auto path = ImFrame::OpenFileDialog({ {"Image files", "png,jpg" } }, nullptr);
 	if (path)
 	{
-		auto ret = ImFrame::LoadTexture(path.value().string().c_str());
-		if (ret)
-		{
-			if (m_texture.textureID)
-				glDeleteTextures(1, &m_texture.textureID);
-			m_texture = ret.value();
-			m_showTexture = true;
-		}
+		m_texture = ImFrame::LoadCachedTexture(path.value().string().c_str());
+		m_showTexture = true;
 	}
 }
 
@@ -46,7 +46,8 @@ namespace Features
 		bool m_showImPlotDemo = false;
 		bool m_setBgColor = false;
 		bool m_setUiFont = false;
-		ImFrame::TextureInfo m_texture;
+		bool m_powerSaving = false;
+		ImFrame::CachedTexturePtr m_texture;
 		bool m_showTexture = false;
         bool m_showAbout = false;
 	};
@@ -41,6 +41,14 @@ namespace Features
 			return;
 		}
 
+		// Registered fonts can be used alongside the UI font
+		if (ImFont * headingFont = ImFrame::GetFont(ImFrame::FontType::RobotoMedium, 24.0f))
+		{
+			ImGui::PushFont(headingFont);
+			ImGui::TextUnformatted("UI Font Settings");
+			ImGui::PopFont();
+		}
+
 		bool enableCustomFont = ImFrame::IsCustomFontEnabled();
 		if (ImGui::Checkbox("Enable Custom UI Font", &enableCustomFont))
 			ImFrame::EnableCustomFont(enableCustomFont);
@@ -62,6 +70,9 @@ namespace Features
 				fontSize = std::clamp<ImU8>(fontSize, 10, 24);
 				ImFrame::SetCustomFontSize(static_cast<float>(fontSize));
 			}
+			bool sdfFont = ImFrame::IsSdfFontEnabled();
+			if (ImGui::Checkbox("Distance Field Rendering", &sdfFont))
+				ImFrame::EnableSdfFont(sdfFont);
 		}
 		ImGui::End();
 	}
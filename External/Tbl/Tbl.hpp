@@ -42,18 +42,37 @@ THE SOFTWARE.
 #endif
 #endif
 
+// Instruction set definitions
+#if defined(__AVX2__)
+#define TBL_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TBL_SSE2
+#endif
+
 #include <cassert>
+#include <cstdint>
 #include <variant>
 #include <string>
 #include <string_view>
 #include <vector>
 #include <unordered_map>
+#include <deque>
 #include <algorithm>
+#include <limits>
+#include <thread>
 #ifdef USE_FROM_CHARS
 #include <charconv>
 #else
 #include <sstream>
 #endif
+#if defined(TBL_AVX2)
+#include <immintrin.h>
+#elif defined(TBL_SSE2)
+#include <emmintrin.h>
+#endif
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
 
 #ifdef TBL_WINDOWS
 #pragma warning(pop)
@@ -67,67 +86,9 @@ namespace Tbl
 	const size_t DoubleType = 1;
 	const size_t StringType = 2;
 
-	// Table class reads and parses CSV or tab-delimited text
-	template<typename Alloc = std::allocator<char>>
-	class Table
+	// Parsing shared by all table types
+	namespace Detail
 	{
-	public:
-		using String = std::basic_string<char, std::char_traits<char>, Alloc>;
-		using TableData = std::variant<int64_t, double, String>;
-	private:
-		using TableDataAlloc = typename std::allocator_traits<Alloc>::template rebind_alloc<TableData>;
-		using VectorTableData = std::vector<TableData, TableDataAlloc>;
-		using StringIndexPair = std::pair<const String, size_t>;
-		using StringIndexPairAlloc = typename std::allocator_traits<Alloc>::template rebind_alloc<StringIndexPair>;
-		using StringIndexMap = std::unordered_map<const String, size_t, std::hash<String>, std::equal_to<String>, StringIndexPairAlloc>;
-	public:
-
-		Table(std::string_view text)
-		{
-			m_error = !Read(text);
-		}
-
-		explicit operator bool() const { return !m_error; }
-
-		size_t GetNumColumns() const { return m_columnMap.size(); }
-		size_t GetNumRows() const { return m_rowMap.size(); }
-		size_t GetRowIndex(const String & rowName) const
-		{
-			const auto& pair = m_rowMap.find(rowName);
-			assert(pair != m_rowMap.end());
-			return pair->second;
-		}
-		size_t GetColumnIndex(const String & columnName) const
-		{
-			const auto& pair = m_columnMap.find(columnName);
-			assert(pair != m_columnMap.end());
-			return pair->second;
-		}
-		const TableData& GetData(size_t rowIndex, size_t columnIndex) const
-		{
-			assert(!m_error);
-			assert(rowIndex < GetNumRows());
-			assert(columnIndex < GetNumColumns());
-			size_t index = columnIndex + (rowIndex * GetNumColumns());
-			assert(index < m_tableData.size());
-			return m_tableData[index];
-		}
-		const TableData& GetData(const String & rowName, const String & columnName) const
-		{
-			return GetData(GetRowIndex(rowName), GetColumnIndex(columnName));
-		}
-		template <typename T>
-		const T & Get(size_t rowIndex, size_t columnIndex) const
-		{
-			return std::get<T>(GetData(rowIndex, columnIndex));
-		}
-		template <typename T>
-		const T & Get(const String & rowName, const String & columnName) const
-		{
-			return std::get<T>(GetData(GetRowIndex(rowName), GetColumnIndex(columnName)));
-		}
-
-	private:
 
 		enum class Format
 		{
@@ -135,22 +96,22 @@ namespace Tbl
 			Continental
 		};
 
-		bool IsLineEnd(std::string_view::const_iterator current) const
+		inline bool IsLineEnd(char c)
 		{
-			return *current == '\n' || *current == '\r';
+			return c == '\n' || c == '\r';
 		}
 
-		void AdvanceToNextLine(std::string_view text, std::string_view::const_iterator & current) const
+		inline void AdvanceToNextLine(std::string_view text, std::string_view::const_iterator & current)
 		{
 			while (current != text.end())
 			{
-				if (!IsLineEnd(current))
+				if (!IsLineEnd(*current))
 					break;
 				++current;
 			}
 		}
 
-		bool DetectDelimiter(std::string_view text, char & delimiter, Format & format) const
+		inline bool DetectDelimiter(std::string_view text, char & delimiter, Format & format)
 		{
 			size_t tabCount = 0;
 			size_t commaCount = 0;
@@ -165,7 +126,7 @@ namespace Tbl
 					++tabCount;
 				else if (c == ';')
 					++semicolonCount;
-				else if (IsLineEnd(current))
+				else if (IsLineEnd(c))
 					break;
 				++current;
 			}
@@ -176,29 +137,19 @@ namespace Tbl
 			return true;
 		}
 
-        bool ParseInteger(const String & str, int64_t& intValue) const
-        {
-#ifdef USE_FROM_CHARS
-            auto result = std::from_chars(str.data(), str.data() + str.size(), intValue);
-            if (result.ptr == str.data() + str.size())
-                return true;
-            return false;
-#else
-            char * endPtr;
-            intValue = strtoll(str.data(), &endPtr, 10);
-            if (endPtr != (str.data() + str.size()))
-                return false;
-            return true;
-#endif
-        }
+		inline bool IsDigit(char c)
+		{
+			return c >= '0' && c <= '9';
+		}
 
-        bool ParseDouble(const String & str, double & doubleValue, Format format) const
-        {
+		// Exact but slow, so only used by ParseNumber() for numbers outside its fast path
+		inline bool ParseDouble(std::string_view str, double & doubleValue, Format format)
+		{
 #ifdef USE_FROM_CHARS
 			// In case contintental format is used, replace commas with decimal point
 			if (format == Format::Continental)
 			{
-				String s = str;
+				std::string s(str);
 				std::replace(s.begin(), s.end(), ',', '.');
 				auto result = std::from_chars(s.data(), s.data() + s.size(), doubleValue);
 				if (result.ptr == s.data() + s.size())
@@ -210,105 +161,473 @@ namespace Tbl
 				if (result.ptr == str.data() + str.size())
 					return true;
 			}
-            return false;
+			return false;
 #else
+			std::string s(str);
 			if (format == Format::Continental)
-			{
-				String s = str;
 				std::replace(s.begin(), s.end(), ',', '.');
-				std::istringstream istr(s.c_str());
-				istr.imbue(std::locale::classic());
-				istr >> doubleValue;
-				if (istr.fail())
-					return false;
+			std::istringstream istr(s);
+			istr.imbue(std::locale::classic());
+			istr >> doubleValue;
+			if (istr.fail())
+				return false;
+			return true;
+#endif
+		}
+
+		// Parses an integer or floating point number in a single pass over the text, without copying it or
+		// consulting the locale.  The decimal separator is a point, or either a point or comma in continental
+		// format.  Spaces around the number are ignored, but anything else makes the cell text.  Returns IntType
+		// or DoubleType, with the matching value set, or StringType if the text isn't a number.
+		//
+		// Up to 19 significant digits are accumulated as an integer.  If that's within a double's 53 bit
+		// mantissa, and the decimal exponent is within 22, the power of ten is exact too, so a single multiply or
+		// divide gives a correctly rounded result.  Anything else is rare enough to fall back on ParseDouble().
+		inline size_t ParseNumber(std::string_view str, Format format, int64_t & intValue, double & doubleValue)
+		{
+			static const double powersOfTen[] =
+			{
+				1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+				1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+			};
+			const int maxExactPower = 22;
+			const int maxDigits = 19;
+
+			const char * current = str.data();
+			const char * end = current + str.size();
+			while (current != end && *current == ' ')
+				++current;
+			while (end != current && *(end - 1) == ' ')
+				--end;
+
+			const bool negative = current != end && *current == '-';
+			if (current != end && (*current == '-' || *current == '+'))
+				++current;
+			const char * start = current;
+
+			// Digits past the first nineteen significant ones only adjust the exponent
+			uint64_t mantissa = 0;
+			int digits = 0;
+			int exponent = 0;
+			bool truncated = false;
+			const char * digitsStart = current;
+			for (; current != end && IsDigit(*current); ++current)
+			{
+				if (digits < maxDigits)
+				{
+					mantissa = mantissa * 10 + (*current - '0');
+					digits += mantissa != 0;
+				}
+				else
+				{
+					++exponent;
+					truncated = true;
+				}
 			}
-			else
+			size_t digitCount = current - digitsStart;
+
+			bool integer = true;
+			if (current != end && (*current == '.' || (*current == ',' && format == Format::Continental)))
 			{
-				std::istringstream istr(str.c_str());
-				istr.imbue(std::locale::classic());
-				istr >> doubleValue;
-				if (istr.fail())
-					return false;
+				integer = false;
+				digitsStart = ++current;
+				for (; current != end && IsDigit(*current); ++current)
+				{
+					if (digits < maxDigits)
+					{
+						mantissa = mantissa * 10 + (*current - '0');
+						digits += mantissa != 0;
+						--exponent;
+					}
+					else
+						truncated = true;
+				}
+				digitCount += current - digitsStart;
 			}
-            return true;
-#endif
-        }
+			if (digitCount == 0)
+				return StringType;
 
-		TableData ParseData(const String & str, Format format) const
+			if (current != end && (*current == 'e' || *current == 'E'))
+			{
+				integer = false;
+				++current;
+				const bool negativeExponent = current != end && *current == '-';
+				if (current != end && (*current == '-' || *current == '+'))
+					++current;
+				if (current == end || !IsDigit(*current))
+					return StringType;
+				int value = 0;
+				for (; current != end && IsDigit(*current); ++current)
+				{
+					if (value < 100000)
+						value = value * 10 + (*current - '0');
+				}
+				exponent += negativeExponent ? -value : value;
+			}
+			if (current != end)
+				return StringType;
+
+			const uint64_t maxInteger = uint64_t(std::numeric_limits<int64_t>::max());
+			if (integer && !truncated && mantissa <= maxInteger + negative)
+			{
+				if (!negative)
+					intValue = int64_t(mantissa);
+				else if (mantissa > maxInteger)
+					intValue = std::numeric_limits<int64_t>::min();
+				else
+					intValue = -int64_t(mantissa);
+				return IntType;
+			}
+			if (!truncated && mantissa <= (uint64_t(1) << 53) && exponent >= -maxExactPower && exponent <= maxExactPower)
+			{
+				double value = double(mantissa);
+				if (exponent < 0)
+					value /= powersOfTen[-exponent];
+				else
+					value *= powersOfTen[exponent];
+				doubleValue = negative ? -value : value;
+				return DoubleType;
+			}
+			if (!ParseDouble(std::string_view(start, end - start), doubleValue, format))
+				return StringType;
+			if (negative)
+				doubleValue = -doubleValue;
+			return DoubleType;
+		}
+
+		inline size_t CountTrailingZeros(uint64_t mask)
 		{
-			int64_t intValue = 0;
-			if (ParseInteger(str, intValue))
-				return intValue;
-			else
+			assert(mask != 0);
+#if defined(_MSC_VER) && defined(_M_X64)
+			unsigned long index = 0;
+			_BitScanForward64(&index, mask);
+			return index;
+#elif defined(__GNUC__)
+			return __builtin_ctzll(mask);
+#else
+			size_t index = 0;
+			while (!(mask & 1))
 			{
-				double doubleValue = 0.0;
-				if (ParseDouble(str, doubleValue, format))
-					return doubleValue;
+				mask >>= 1;
+				++index;
 			}
-			return str;
+			return index;
+#endif
 		}
 
-		String ParseCell(std::string_view text, char delimiter, std::string_view::const_iterator & current) const
+		// Finds structural characters - delimiters, double quotes and line ends.  With SSE2 or AVX2, a block of
+		// 64 characters is compared 16 or 32 at a time, giving a bitmask with a bit set for each one in the block.
+		// The block's mask is kept, so finding successive cells within it takes only a bit scan each.  Otherwise,
+		// characters are tested one at a time.
+		class Scanner
+		{
+		public:
+			Scanner(std::string_view text, char delimiter) :
+				m_text(text),
+				m_delimiter(delimiter),
+				m_mask(ScanBlock(0))
+			{
+			}
+
+			std::string_view GetText() const { return m_text; }
+			char GetDelimiter() const { return m_delimiter; }
+
+			// Set when a double quote was found that doesn't start or end a quoted cell, or escape another
+			bool HasStrayQuote() const { return m_strayQuote; }
+			void SetStrayQuote() { m_strayQuote = true; }
+
+			// Returns the position of the first structural character at or after pos, or the text size if none
+			size_t Find(size_t pos)
+			{
+#if defined(TBL_AVX2) || defined(TBL_SSE2)
+				while (true)
+				{
+					// Unsigned, so this is also false if pos is before the block
+					if (pos - m_block < BlockSize)
+					{
+						const uint64_t mask = m_mask & (~uint64_t(0) << (pos - m_block));
+						if (mask)
+							return m_block + CountTrailingZeros(mask);
+						pos = m_block + BlockSize;
+					}
+					if (pos >= m_text.size())
+						return m_text.size();
+					m_block = pos;
+					m_mask = ScanBlock(pos);
+				}
+#else
+				const char delimiter = m_delimiter;
+				const char * chars = m_text.data();
+				const size_t size = m_text.size();
+				while (pos < size)
+				{
+					const char c = chars[pos];
+					if (c == delimiter || c == '"' || IsLineEnd(c))
+						break;
+					++pos;
+				}
+				return pos;
+#endif
+			}
+
+		private:
+			static const size_t BlockSize = 64;
+
+			bool IsStructural(char c) const
+			{
+				return c == m_delimiter || c == '"' || IsLineEnd(c);
+			}
+
+			uint64_t ScanChars(const char * chars, size_t count) const
+			{
+				uint64_t mask = 0;
+				for (size_t i = 0; i < count; ++i)
+				{
+					if (IsStructural(chars[i]))
+						mask |= uint64_t(1) << i;
+				}
+				return mask;
+			}
+
+			uint64_t ScanBlock(size_t pos) const
+			{
+				const char * chars = m_text.data() + pos;
+				if (m_text.size() - pos < BlockSize)
+					return ScanChars(chars, m_text.size() - pos);
+#if defined(TBL_AVX2)
+				const __m256i delimiter = _mm256_set1_epi8(m_delimiter);
+				const __m256i quote = _mm256_set1_epi8('"');
+				const __m256i newline = _mm256_set1_epi8('\n');
+				const __m256i carriageReturn = _mm256_set1_epi8('\r');
+				uint64_t mask = 0;
+				for (size_t i = 0; i < BlockSize; i += 32)
+				{
+					const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(chars + i));
+					const __m256i matches = _mm256_or_si256(
+						_mm256_or_si256(_mm256_cmpeq_epi8(v, delimiter), _mm256_cmpeq_epi8(v, quote)),
+						_mm256_or_si256(_mm256_cmpeq_epi8(v, newline), _mm256_cmpeq_epi8(v, carriageReturn)));
+					mask |= uint64_t(uint32_t(_mm256_movemask_epi8(matches))) << i;
+				}
+				return mask;
+#elif defined(TBL_SSE2)
+				const __m128i delimiter = _mm_set1_epi8(m_delimiter);
+				const __m128i quote = _mm_set1_epi8('"');
+				const __m128i newline = _mm_set1_epi8('\n');
+				const __m128i carriageReturn = _mm_set1_epi8('\r');
+				uint64_t mask = 0;
+				for (size_t i = 0; i < BlockSize; i += 16)
+				{
+					const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(chars + i));
+					const __m128i matches = _mm_or_si128(
+						_mm_or_si128(_mm_cmpeq_epi8(v, delimiter), _mm_cmpeq_epi8(v, quote)),
+						_mm_or_si128(_mm_cmpeq_epi8(v, newline), _mm_cmpeq_epi8(v, carriageReturn)));
+					mask |= uint64_t(uint32_t(_mm_movemask_epi8(matches))) << i;
+				}
+				return mask;
+#else
+				return ScanChars(chars, BlockSize);
+#endif
+			}
+
+			std::string_view m_text;
+			char m_delimiter = 0;
+			size_t m_block = 0;
+			uint64_t m_mask = 0;
+			bool m_strayQuote = false;
+		};
+
+		// Returns the text of the cell at current, without surrounding double quotes, and advances current to
+		// the delimiter or line end following it.  Escaped is set if the text contains doubled quotes, which
+		// Unescape() reduces to single ones.
+		inline std::string_view ParseCell(Scanner & scanner, std::string_view::const_iterator & current, bool & escaped)
 		{
+			escaped = false;
+			const std::string_view text = scanner.GetText();
+			size_t pos = current - text.begin();
+
 			// Check if this cell is double-quoted
 			bool quoted = *current == '"';
 			if (quoted)
-				++current;
+				++pos;
 
-			String str;
-			while (current != text.end())
+			const size_t start = pos;
+			size_t end = text.size();
+			while ((pos = scanner.Find(pos)) != text.size())
 			{
-				const char c = *current;
+				const char c = text[pos];
 				if (quoted)
 				{
-					// Since this cell is double-quote delimited, proceed without checking delimiters until
-					// we see another double quote character.
+					// Since this cell is double-quote delimited, skip delimiters until we see another double
+					// quote character.
 					if (c == '"')
 					{
-						// Advance the iterator and check to see if it's followed by the end of file or
-						// delimiters.  If so, we're done parsing.  If not, a second double-quote should
-						// follow.
-						++current;
-						if (current == text.end() || *current == delimiter || IsLineEnd(current))
+						// Advance past it and check to see if it's followed by the end of file or delimiters.
+						// If so, we're done parsing.  If not, a second double-quote should follow.
+						end = pos;
+						++pos;
+						if (pos == text.size() || text[pos] == scanner.GetDelimiter() || IsLineEnd(text[pos]))
 							break;
 						// If this assert hits, your data is malformed, since an interior double-quote was not
 						// followed by a second quote
-						assert(*current == '"');
+						assert(text[pos] == '"');
+						if (text[pos] != '"')
+							scanner.SetStrayQuote();
+						escaped = true;
+						end = text.size();
 					}
 				}
 				else
 				{
-					// This isn't a quote-escaped cell, so check for normal delimiters
-					if (c == delimiter || IsLineEnd(current))
+					// This isn't a quote-escaped cell, so a double quote is just part of the text
+					if (c != '"')
+					{
+						end = pos;
 						break;
+					}
+					scanner.SetStrayQuote();
 				}
-				str += c;
-				++current;
+				++pos;
+			}
+			current = text.begin() + pos;
+			return text.substr(start, end - start);
+		}
+
+		// Calls task(i) for every i below count, each on its own thread, with the calling thread taking the first
+		template<typename Task>
+		void RunParallel(size_t count, const Task & task)
+		{
+			std::vector<std::thread> threads;
+			threads.reserve(count > 0 ? count - 1 : 0);
+			for (size_t i = 1; i < count; ++i)
+				threads.emplace_back([&task, i] () { task(i); });
+			if (count > 0)
+				task(0);
+			for (auto & thread : threads)
+				thread.join();
+		}
+
+		template<typename String>
+		String Unescape(std::string_view cell, const typename String::allocator_type & alloc = typename String::allocator_type())
+		{
+			String str(alloc);
+			str.reserve(cell.size());
+			for (size_t i = 0; i < cell.size(); ++i)
+			{
+				str += cell[i];
+				if (cell[i] == '"' && i + 1 < cell.size() && cell[i + 1] == '"')
+					++i;
 			}
 			return str;
 		}
 
-		bool ReadHeader(std::string_view text, std::string_view::const_iterator & current, char delimiter)
+	}
+
+	// Table class reads and parses CSV or tab-delimited text
+	template<typename Alloc = std::allocator<char>>
+	class Table
+	{
+	public:
+		using String = std::basic_string<char, std::char_traits<char>, Alloc>;
+		using TableData = std::variant<int64_t, double, String>;
+	private:
+		using TableDataAlloc = typename std::allocator_traits<Alloc>::template rebind_alloc<TableData>;
+		using VectorTableData = std::vector<TableData, TableDataAlloc>;
+		using StringIndexPair = std::pair<const String, size_t>;
+		using StringIndexPairAlloc = typename std::allocator_traits<Alloc>::template rebind_alloc<StringIndexPair>;
+		using StringIndexMap = std::unordered_map<const String, size_t, std::hash<String>, std::equal_to<String>, StringIndexPairAlloc>;
+	public:
+
+		Table(std::string_view text)
+		{
+			m_error = !Read(text);
+		}
+
+		explicit operator bool() const { return !m_error; }
+
+		size_t GetNumColumns() const { return m_columnMap.size(); }
+		size_t GetNumRows() const { return m_rowMap.size(); }
+		size_t GetRowIndex(const String & rowName) const
+		{
+			const auto& pair = m_rowMap.find(rowName);
+			assert(pair != m_rowMap.end());
+			return pair->second;
+		}
+		size_t GetColumnIndex(const String & columnName) const
+		{
+			const auto& pair = m_columnMap.find(columnName);
+			assert(pair != m_columnMap.end());
+			return pair->second;
+		}
+		const TableData& GetData(size_t rowIndex, size_t columnIndex) const
+		{
+			assert(!m_error);
+			assert(rowIndex < GetNumRows());
+			assert(columnIndex < GetNumColumns());
+			size_t index = columnIndex + (rowIndex * GetNumColumns());
+			assert(index < m_tableData.size());
+			return m_tableData[index];
+		}
+		const TableData& GetData(const String & rowName, const String & columnName) const
+		{
+			return GetData(GetRowIndex(rowName), GetColumnIndex(columnName));
+		}
+		template <typename T>
+		const T & Get(size_t rowIndex, size_t columnIndex) const
+		{
+			return std::get<T>(GetData(rowIndex, columnIndex));
+		}
+		template <typename T>
+		const T & Get(const String & rowName, const String & columnName) const
+		{
+			return std::get<T>(GetData(GetRowIndex(rowName), GetColumnIndex(columnName)));
+		}
+
+	private:
+
+		using Format = Detail::Format;
+
+		TableData ParseData(const String & str, Format format) const
+		{
+			int64_t intValue = 0;
+			double doubleValue = 0.0;
+			const size_t type = Detail::ParseNumber(std::string_view(str.data(), str.size()), format, intValue, doubleValue);
+			if (type == IntType)
+				return intValue;
+			if (type == DoubleType)
+				return doubleValue;
+			return str;
+		}
+
+		String ParseCell(Detail::Scanner & scanner, std::string_view::const_iterator & current) const
+		{
+			bool escaped = false;
+			auto cell = Detail::ParseCell(scanner, current, escaped);
+			if (escaped)
+				return Detail::Unescape<String>(cell);
+			return String(cell.begin(), cell.end());
+		}
+
+		bool ReadHeader(std::string_view text, std::string_view::const_iterator & current, Detail::Scanner & scanner)
 		{
 			while (current != text.end())
 			{
-				auto str = ParseCell(text, delimiter, current);
+				auto str = ParseCell(scanner, current);
 				m_columnMap.insert({ str, m_columnMap.size() });
-				if (IsLineEnd(current))
+				if (current == text.end() || Detail::IsLineEnd(*current))
 					break;
 				++current;
 			}
-			AdvanceToNextLine(text, current);
+			Detail::AdvanceToNextLine(text, current);
 			return true;
 		}
 
-		bool ReadRow(std::string_view text, std::string_view::const_iterator & current, char delimiter, Format format)
+		bool ReadRow(std::string_view text, std::string_view::const_iterator & current, Detail::Scanner & scanner, Format format)
 		{
 			// Track column data
 			size_t column = 0;
 			while (current != text.end())
 			{
-				auto str = ParseCell(text, delimiter, current);
+				auto str = ParseCell(scanner, current);
 				if (column == 0)
 				{
 					m_rowMap.insert({ str, m_rowMap.size() });
@@ -317,19 +636,19 @@ namespace Tbl
 				else
 					m_tableData.push_back(ParseData(str, format));
 				++column;
-				if (current == text.end() || IsLineEnd(current))
+				if (current == text.end() || Detail::IsLineEnd(*current))
 					break;
 				++current;
 			}
-			AdvanceToNextLine(text, current);
+			Detail::AdvanceToNextLine(text, current);
 			return column == GetNumColumns();
 		}
 
-		bool ReadRows(std::string_view text, std::string_view::const_iterator & current, char delimiter, Format format)
+		bool ReadRows(std::string_view text, std::string_view::const_iterator & current, Detail::Scanner & scanner, Format format)
 		{
 			while (current != text.end())
 			{
-				if (!ReadRow(text, current, delimiter, format))
+				if (!ReadRow(text, current, scanner, format))
 					return false;
 			}
 			return true;
@@ -339,12 +658,13 @@ namespace Tbl
 		{
 			char delimiter = 0;
 			Format format = Format::International;
-			if (!DetectDelimiter(text, delimiter, format))
+			if (!Detail::DetectDelimiter(text, delimiter, format))
 				return false;
+			Detail::Scanner scanner(text, delimiter);
 			std::string_view::const_iterator current = text.begin();
-			if (!ReadHeader(text, current, delimiter))
+			if (!ReadHeader(text, current, scanner))
 				return false;
-			if (!ReadRows(text, current, delimiter, format))
+			if (!ReadRows(text, current, scanner, format))
 				return false;
 			return true;
 		}
@@ -355,6 +675,475 @@ namespace Tbl
 		bool m_error = false;
 	};
 
+	// Non-owning view of contiguous values, like C++20's std::span
+	template<typename T>
+	class Span
+	{
+	public:
+		Span() = default;
+		Span(T * data, size_t size) : m_data(data), m_size(size) {}
+
+		T * data() const { return m_data; }
+		size_t size() const { return m_size; }
+		bool empty() const { return m_size == 0; }
+		T * begin() const { return m_data; }
+		T * end() const { return m_data + m_size; }
+		T & operator[](size_t index) const
+		{
+			assert(index < m_size);
+			return m_data[index];
+		}
+
+	private:
+		T * m_data = nullptr;
+		size_t m_size = 0;
+	};
+
+	// TableView reads the same text as Table, but without copying it.  Text cells are views into the text,
+	// which must outlive the table.  Only quoted cells containing escaped quotes are copied, since their text
+	// differs from the original.
+	//
+	// Cells are stored by column rather than by row.  Each column's type is inferred from its first rows, and
+	// its values are stored contiguously, so a numeric column can be accessed as a span, such as for plotting.
+	// Integers in a floating point column are stored as doubles.  Cells of any other type are kept separately,
+	// returned by GetData(), while the span holds a placeholder: zero for integers, NaN for doubles, and an
+	// empty string for text.  The first column holds row names, so it's always text.
+	//
+	// Large text can be parsed by several threads, each reading whole rows from its own part of the text.
+	// Parts are split at line ends outside quoted cells, found by counting quotes, so double quotes may only
+	// appear in quoted cells, escaped by doubling, as in RFC 4180.
+	class TableView
+	{
+	public:
+		using TableData = std::variant<int64_t, double, std::string_view>;
+
+		TableView(std::string_view text, size_t threadCount = 1)
+		{
+			m_error = !Read(text, threadCount);
+		}
+		TableView(const TableView &) = delete;
+		TableView & operator = (const TableView &) = delete;
+
+		explicit operator bool() const { return !m_error; }
+
+		size_t GetNumColumns() const { return m_columns.size(); }
+		size_t GetNumRows() const { return m_numRows; }
+		bool HasRow(std::string_view rowName) const { return m_rowMap.count(rowName) != 0; }
+		bool HasColumn(std::string_view columnName) const { return m_columnMap.count(columnName) != 0; }
+		size_t GetRowIndex(std::string_view rowName) const
+		{
+			const auto& pair = m_rowMap.find(rowName);
+			assert(pair != m_rowMap.end());
+			return pair->second;
+		}
+		size_t GetColumnIndex(std::string_view columnName) const
+		{
+			const auto& pair = m_columnMap.find(columnName);
+			assert(pair != m_columnMap.end());
+			return pair->second;
+		}
+		size_t GetColumnType(size_t columnIndex) const
+		{
+			assert(columnIndex < GetNumColumns());
+			return m_columns[columnIndex].type;
+		}
+		TableData GetData(size_t rowIndex, size_t columnIndex) const
+		{
+			assert(!m_error);
+			assert(rowIndex < GetNumRows());
+			assert(columnIndex < GetNumColumns());
+			const Column & column = m_columns[columnIndex];
+			if (!column.exceptions.empty())
+			{
+				auto exception = std::lower_bound(column.exceptions.begin(), column.exceptions.end(), rowIndex, [] (const auto & pair, size_t row) { return pair.first < row; });
+				if (exception != column.exceptions.end() && exception->first == rowIndex)
+					return exception->second;
+			}
+			if (column.type == IntType)
+				return column.ints[rowIndex];
+			if (column.type == DoubleType)
+				return column.doubles[rowIndex];
+			return column.strings[rowIndex];
+		}
+		TableData GetData(std::string_view rowName, std::string_view columnName) const
+		{
+			return GetData(GetRowIndex(rowName), GetColumnIndex(columnName));
+		}
+		template <typename T>
+		T Get(size_t rowIndex, size_t columnIndex) const
+		{
+			return std::get<T>(GetData(rowIndex, columnIndex));
+		}
+		template <typename T>
+		T Get(std::string_view rowName, std::string_view columnName) const
+		{
+			return std::get<T>(GetData(GetRowIndex(rowName), GetColumnIndex(columnName)));
+		}
+
+		// Empty unless the column is of the requested type
+		Span<const int64_t> GetIntColumn(size_t columnIndex) const
+		{
+			assert(columnIndex < GetNumColumns());
+			const auto & ints = m_columns[columnIndex].ints;
+			return Span<const int64_t>(ints.data(), ints.size());
+		}
+		Span<const double> GetDoubleColumn(size_t columnIndex) const
+		{
+			assert(columnIndex < GetNumColumns());
+			const auto & doubles = m_columns[columnIndex].doubles;
+			return Span<const double>(doubles.data(), doubles.size());
+		}
+		Span<const std::string_view> GetStringColumn(size_t columnIndex) const
+		{
+			assert(columnIndex < GetNumColumns());
+			const auto & strings = m_columns[columnIndex].strings;
+			return Span<const std::string_view>(strings.data(), strings.size());
+		}
+
+	private:
+
+		using Format = Detail::Format;
+
+		// Number of rows used to infer column types, before the rest are parsed in parallel
+		static const size_t TypeSampleRows = 1000;
+
+		// Smallest part of the text worth parsing on its own thread
+		static const size_t MinPartSize = 1 << 20;
+
+		// Values of the column's type, and cells of other types, sorted by row
+		struct Column
+		{
+			size_t type = StringType;
+			std::vector<int64_t> ints;
+			std::vector<double> doubles;
+			std::vector<std::string_view> strings;
+			std::vector<std::pair<size_t, TableData>> exceptions;
+		};
+
+		// Rows parsed from one part of the text, numbered from the start of the part
+		struct Part
+		{
+			std::vector<Column> columns;
+			std::deque<std::string> strings;
+			size_t numRows = 0;
+			bool error = false;
+			bool strayQuote = false;
+		};
+
+		static TableData ParseData(std::string_view str, Format format)
+		{
+			int64_t intValue = 0;
+			double doubleValue = 0.0;
+			const size_t type = Detail::ParseNumber(str, format, intValue, doubleValue);
+			if (type == IntType)
+				return intValue;
+			if (type == DoubleType)
+				return doubleValue;
+			return str;
+		}
+
+		// Unescaped copies are kept in a deque, so views of them stay valid as more are added
+		static std::string_view ParseCell(Detail::Scanner & scanner, std::string_view::const_iterator & current, std::deque<std::string> & strings)
+		{
+			bool escaped = false;
+			auto cell = Detail::ParseCell(scanner, current, escaped);
+			if (escaped)
+				return strings.emplace_back(Detail::Unescape<std::string>(cell));
+			return cell;
+		}
+
+		// Integers are converted, while cells that didn't fit the integer column become NaN, as they would have
+		// in a floating point column
+		static void PromoteToDouble(Column & column)
+		{
+			assert(column.type == IntType);
+			column.type = DoubleType;
+			column.doubles.reserve(column.ints.capacity());
+			column.doubles.assign(column.ints.begin(), column.ints.end());
+			column.ints = std::vector<int64_t>();
+			for (const auto & exception : column.exceptions)
+				column.doubles[exception.first] = std::numeric_limits<double>::quiet_NaN();
+		}
+
+		// A floating point value in an integer column makes it a floating point column, so only cells that
+		// aren't numbers become exceptions in numeric columns
+		static void Append(Column & column, size_t row, const TableData & data)
+		{
+			if (column.type == IntType)
+			{
+				if (data.index() == IntType)
+				{
+					column.ints.push_back(std::get<IntType>(data));
+					return;
+				}
+				if (data.index() == DoubleType)
+				{
+					PromoteToDouble(column);
+					column.doubles.push_back(std::get<DoubleType>(data));
+					return;
+				}
+				column.ints.push_back(0);
+			}
+			else if (column.type == DoubleType)
+			{
+				if (data.index() == DoubleType)
+				{
+					column.doubles.push_back(std::get<DoubleType>(data));
+					return;
+				}
+				if (data.index() == IntType)
+				{
+					column.doubles.push_back(static_cast<double>(std::get<IntType>(data)));
+					return;
+				}
+				column.doubles.push_back(std::numeric_limits<double>::quiet_NaN());
+			}
+			else
+			{
+				if (data.index() == StringType)
+				{
+					column.strings.push_back(std::get<StringType>(data));
+					return;
+				}
+				column.strings.emplace_back();
+			}
+			column.exceptions.emplace_back(row, data);
+		}
+
+		// Calls dataFn(column, data) for each cell in the row, returning false unless there's one per column
+		template<typename DataFn>
+		bool ReadRow(std::string_view text, std::string_view::const_iterator & current, Detail::Scanner & scanner, Format format, std::deque<std::string> & strings, const DataFn & dataFn) const
+		{
+			size_t column = 0;
+			while (current != text.end())
+			{
+				auto str = ParseCell(scanner, current, strings);
+				if (column >= GetNumColumns())
+					return false;
+				dataFn(column, column == 0 ? TableData(str) : ParseData(str, format));
+				++column;
+				if (current == text.end() || Detail::IsLineEnd(*current))
+					break;
+				++current;
+			}
+			Detail::AdvanceToNextLine(text, current);
+			return column == GetNumColumns();
+		}
+
+		// A column is numeric if most of its non-empty cells are numbers, and floating point if any are
+		void InferColumnTypes(const std::vector<TableData> & sample)
+		{
+			const size_t numColumns = GetNumColumns();
+			for (size_t c = 1; c < numColumns; ++c)
+			{
+				size_t intCount = 0;
+				size_t doubleCount = 0;
+				size_t stringCount = 0;
+				for (size_t i = c; i < sample.size(); i += numColumns)
+				{
+					const auto & data = sample[i];
+					if (data.index() == IntType)
+						++intCount;
+					else if (data.index() == DoubleType)
+						++doubleCount;
+					else if (!std::get<StringType>(data).empty())
+						++stringCount;
+				}
+				auto & column = m_columns[c];
+				if (stringCount >= intCount + doubleCount)
+					column.type = StringType;
+				else
+					column.type = doubleCount ? DoubleType : IntType;
+			}
+			for (size_t i = 0; i < sample.size(); ++i)
+				Append(m_columns[i % numColumns], i / numColumns, sample[i]);
+			m_numRows = sample.size() / numColumns;
+		}
+
+		// Splits text into about count parts, each ending at a line end outside quoted cells.  Whether a split
+		// point is inside a quoted cell depends on the number of quotes before it, so those are counted for each
+		// part in parallel first.  That assumes every quote starts or ends a quoted cell, or is doubled within
+		// one, which parsing the parts checks.
+		static std::vector<std::string_view> SplitRows(std::string_view text, size_t count)
+		{
+			count = std::min(count, std::max<size_t>(text.size() / MinPartSize, 1));
+			if (count <= 1)
+				return { text };
+			const size_t partSize = text.size() / count;
+			std::vector<size_t> quoteCounts(count);
+			Detail::RunParallel(count, [&] (size_t i)
+			{
+				auto part = text.substr(i * partSize, partSize);
+				quoteCounts[i] = std::count(part.begin(), part.end(), '"');
+			});
+			std::vector<std::string_view> parts;
+			size_t start = 0;
+			size_t quoteCount = 0;
+			for (size_t i = 1; i < count; ++i)
+			{
+				quoteCount += quoteCounts[i - 1];
+				bool quoted = quoteCount % 2 != 0;
+				size_t split = i * partSize;
+				while (split < text.size() && (quoted || !Detail::IsLineEnd(text[split])))
+				{
+					if (text[split] == '"')
+						quoted = !quoted;
+					++split;
+				}
+				while (split < text.size() && Detail::IsLineEnd(text[split]))
+					++split;
+				if (split <= start)
+					continue;
+				parts.push_back(text.substr(start, split - start));
+				start = split;
+			}
+			parts.push_back(text.substr(start));
+			return parts;
+		}
+
+		void ReadPart(std::string_view text, char delimiter, Format format, Part & part) const
+		{
+			part.columns.resize(GetNumColumns());
+			for (size_t c = 0; c < GetNumColumns(); ++c)
+				part.columns[c].type = m_columns[c].type;
+			auto appendFn = [&part] (size_t column, const TableData & data) { Append(part.columns[column], part.numRows, data); };
+			Detail::Scanner scanner(text, delimiter);
+			std::string_view::const_iterator current = text.begin();
+			while (current != text.end())
+			{
+				if (!ReadRow(text, current, scanner, format, part.strings, appendFn))
+				{
+					part.error = true;
+					break;
+				}
+				++part.numRows;
+			}
+			part.strayQuote = scanner.HasStrayQuote();
+		}
+
+		// Parts are appended in order, with their rows renumbered.  Integer columns are promoted first wherever
+		// any part promoted them.  Each column is sized for every row up front, and each part's copy of it is
+		// released as soon as it's appended, so only one column is ever held twice.  Unescaped strings are
+		// swapped rather than moved, so views of them stay valid.
+		bool AppendParts(std::vector<Part> & parts)
+		{
+			size_t numRows = m_numRows;
+			for (const auto & part : parts)
+			{
+				if (part.error)
+					return false;
+				numRows += part.numRows;
+			}
+			for (size_t c = 0; c < GetNumColumns(); ++c)
+			{
+				auto & column = m_columns[c];
+				if (column.type == IntType && std::any_of(parts.begin(), parts.end(), [c] (const Part & part) { return part.columns[c].type == DoubleType; }))
+				{
+					PromoteToDouble(column);
+					for (auto & part : parts)
+					{
+						if (part.columns[c].type == IntType)
+							PromoteToDouble(part.columns[c]);
+					}
+				}
+
+				size_t numExceptions = column.exceptions.size();
+				for (const auto & part : parts)
+					numExceptions += part.columns[c].exceptions.size();
+				if (column.type == IntType)
+					column.ints.reserve(numRows);
+				else if (column.type == DoubleType)
+					column.doubles.reserve(numRows);
+				else
+					column.strings.reserve(numRows);
+				column.exceptions.reserve(numExceptions);
+
+				size_t firstRow = m_numRows;
+				for (auto & part : parts)
+				{
+					auto & partColumn = part.columns[c];
+					column.ints.insert(column.ints.end(), partColumn.ints.begin(), partColumn.ints.end());
+					column.doubles.insert(column.doubles.end(), partColumn.doubles.begin(), partColumn.doubles.end());
+					column.strings.insert(column.strings.end(), partColumn.strings.begin(), partColumn.strings.end());
+					for (const auto & exception : partColumn.exceptions)
+						column.exceptions.emplace_back(exception.first + firstRow, exception.second);
+					firstRow += part.numRows;
+					partColumn = Column();
+				}
+			}
+			m_numRows = numRows;
+			for (auto & part : parts)
+				m_strings.emplace_back().swap(part.strings);
+			return true;
+		}
+
+		bool ReadHeader(std::string_view text, std::string_view::const_iterator & current, Detail::Scanner & scanner)
+		{
+			while (current != text.end())
+			{
+				auto str = ParseCell(scanner, current, m_strings.front());
+				m_columnMap.insert({ str, m_columns.size() });
+				m_columns.emplace_back();
+				if (current == text.end() || Detail::IsLineEnd(*current))
+					break;
+				++current;
+			}
+			Detail::AdvanceToNextLine(text, current);
+			return true;
+		}
+
+		// The first rows are read to infer column types, then the rest are split between threads
+		bool Read(std::string_view text, size_t threadCount)
+		{
+			char delimiter = 0;
+			Format format = Format::International;
+			if (!Detail::DetectDelimiter(text, delimiter, format))
+				return false;
+			Detail::Scanner scanner(text, delimiter);
+			std::string_view::const_iterator current = text.begin();
+			m_strings.emplace_back();
+			if (!ReadHeader(text, current, scanner))
+				return false;
+			std::vector<TableData> sample;
+			auto sampleFn = [&sample] (size_t, const TableData & data) { sample.push_back(data); };
+			for (size_t row = 0; row < TypeSampleRows && current != text.end(); ++row)
+			{
+				if (!ReadRow(text, current, scanner, format, m_strings.front(), sampleFn))
+					return false;
+			}
+			InferColumnTypes(sample);
+
+			// A stray quote, such as in 12" pipe, throws off the quote count, so parts after it may have been
+			// split inside a quoted cell.  The first part with one started in the right place, so it finds it,
+			// and then the text is read again as a single part.
+			const std::string_view rest = text.substr(current - text.begin());
+			auto texts = SplitRows(rest, threadCount);
+			std::vector<Part> parts(texts.size());
+			Detail::RunParallel(texts.size(), [&] (size_t i) { ReadPart(texts[i], delimiter, format, parts[i]); });
+			if (parts.size() > 1 && std::any_of(parts.begin(), parts.end(), [] (const Part & part) { return part.error || part.strayQuote; }))
+			{
+				parts = std::vector<Part>(1);
+				ReadPart(rest, delimiter, format, parts.front());
+			}
+			if (!AppendParts(parts))
+				return false;
+
+			// Row names are always text, so they're all in the first column's strings
+			const auto & rowNames = m_columns.front().strings;
+			m_rowMap.reserve(rowNames.size());
+			for (size_t row = 0; row < rowNames.size(); ++row)
+				m_rowMap.insert({ rowNames[row], row });
+			return true;
+		}
+
+		std::vector<Column> m_columns;
+		size_t m_numRows = 0;
+		std::unordered_map<std::string_view, size_t> m_columnMap;
+		std::unordered_map<std::string_view, size_t> m_rowMap;
+		std::deque<std::deque<std::string>> m_strings;
+		bool m_error = false;
+	};
+
 }
 
 
@@ -1,3 +1,101 @@
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include "stb_image_into.h"
+
+// Route stb_image's allocations through hooks, so images can be decoded straight into caller memory
+static void * stbi_output_malloc(size_t size);
+static void * stbi_output_realloc(void * p, size_t oldSize, size_t newSize);
+static void stbi_output_free(void * p);
+
 #define STB_IMAGE_IMPLEMENTATION
 #define STBI_MAX_DIMENSIONS (1 << 28)
+#define STBI_MALLOC(size) stbi_output_malloc(size)
+#define STBI_REALLOC_SIZED(p, oldSize, newSize) stbi_output_realloc(p, oldSize, newSize)
+#define STBI_FREE(p) stbi_output_free(p)
 #include "stb_image.h"
+
+namespace
+{
+	// Caller's buffer for the image being decoded on this thread.  It's handed to the first allocation of the
+	// output's size, and taken back if that allocation is freed.  The JPEG decoder asks for one byte more than
+	// it writes, so that's allowed for spare.
+	struct OutputBuffer
+	{
+		void * data = nullptr;
+		size_t size = 0;
+		size_t outputSize = 0;
+		size_t spare = 0;
+		bool used = false;
+	};
+
+	thread_local OutputBuffer s_output;
+
+	bool IsJpegFile(const char * filename)
+	{
+		FILE * file = stbi__fopen(filename, "rb");
+		if (!file)
+			return false;
+		unsigned char header[2] = {};
+		const size_t read = fread(header, 1, sizeof(header), file);
+		fclose(file);
+		return read == sizeof(header) && header[0] == 0xFF && header[1] == 0xD8;
+	}
+}
+
+static void * stbi_output_malloc(size_t size)
+{
+	if (s_output.data && !s_output.used && size >= s_output.outputSize && size <= s_output.outputSize + s_output.spare)
+	{
+		s_output.used = true;
+		return s_output.data;
+	}
+	return malloc(size);
+}
+
+static void * stbi_output_realloc(void * p, size_t oldSize, size_t newSize)
+{
+	if (!p || p != s_output.data)
+		return realloc(p, newSize);
+	if (newSize <= s_output.size)
+		return p;
+	void * grown = malloc(newSize);
+	if (!grown)
+		return nullptr;
+	memcpy(grown, p, oldSize);
+	s_output.used = false;
+	return grown;
+}
+
+static void stbi_output_free(void * p)
+{
+	if (p && p == s_output.data)
+		s_output.used = false;
+	else
+		free(p);
+}
+
+int stbi_load_into(char const * filename, stbi_uc * buffer, size_t buffer_size, int * x, int * y, int req_comp)
+{
+	int width = 0;
+	int height = 0;
+	int comp = 0;
+	if (!stbi_info(filename, &width, &height, &comp))
+		return 0;
+	const size_t outputSize = static_cast<size_t>(width) * height * req_comp;
+	if (buffer_size < outputSize)
+		return 0;
+	s_output = OutputBuffer{ buffer, buffer_size, outputSize, IsJpegFile(filename) ? 1u : 0u, false };
+	stbi_uc * pixels = stbi_load(filename, x, y, nullptr, req_comp);
+	s_output = OutputBuffer();
+	if (!pixels)
+		return 0;
+
+	// If the output was allocated some other way, it costs a copy
+	if (pixels != buffer)
+	{
+		memcpy(buffer, pixels, outputSize);
+		stbi_image_free(pixels);
+	}
+	return 1;
+}
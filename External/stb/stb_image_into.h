@@ -0,0 +1,9 @@
+#pragma once
+
+#include <cstddef>
+#include "stb_image.h"
+
+// Decodes an image into the caller's buffer, which must hold at least x * y * req_comp bytes, as reported by
+// stbi_info().  For most formats, stb_image's output allocation is handed the buffer, so the image is never
+// held twice.  Returns zero on failure.
+int stbi_load_into(char const * filename, stbi_uc * buffer, size_t buffer_size, int * x, int * y, int req_comp);
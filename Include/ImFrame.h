@@ -64,6 +64,8 @@ THE SOFTWARE.
 #include <string>
 #include <functional>
 #include <optional>
+#include <variant>
+#include <string_view>
 #include <array>
 #include <vector>
 #include <filesystem>
@@ -145,10 +147,93 @@ namespace ImFrame
 	void SetBackgroundColor(std::array<float, 3> color);
 	std::array<float, 3> GetBackgroundColor();
 
+	// Raw OpenGL - enable if OnUpdate() renders with OpenGL directly.  Otherwise ImGui rendering assumes
+	// it owns all GL state, and skips saving and restoring it each frame.
+	bool IsRawGLEnabled();
+	void EnableRawGL(bool enable);
+
+	// Power saving - when enabled, frames are only rendered in response to input, redraw requests, or
+	// active ImGui widgets, while still guaranteeing the minimum refresh rate.  RequestRedraw() is thread-safe.
+	bool IsPowerSavingEnabled();
+	void EnablePowerSaving(bool enable);
+	float GetMinimumRefreshRate();
+	void SetMinimumRefreshRate(float framesPerSecond);
+	void RequestRedraw();
+	uint64_t GetSkippedFrameCount();
+
+	// Frame statistics - CPU timings are measured in milliseconds for each phase of the main loop.  Time
+	// spent sleeping in power saving mode is excluded from the event timing.  GPU timings are read back
+	// from timer queries a few frames late to avoid stalling, and are zero if timer queries are unsupported.
+	struct FrameTimings
+	{
+		float events{};
+		float fontUpdate{};
+		float textureUploads{};
+		float newFrame{};
+		float appUpdate{};
+		float render{};
+		float renderDrawData{};
+		float platformWindows{};
+		float swapBuffers{};
+		float total{};
+		float gpuAppUpdate{};
+		float gpuRenderDrawData{};
+		float gpuPlatformWindows{};
+	};
+	struct FrameStats
+	{
+		std::vector<FrameTimings> frames;	// Ring buffer of recent frames
+		int offset{};						// Index of the oldest frame in the ring buffer
+		uint64_t frameCount{};
+		uint64_t skippedFrames{};
+	};
+	const FrameStats & GetFrameStats();
+	void SetFrameStatsHistory(int frameCount);
+	bool IsFrameStatsOverlayVisible();
+	void ShowFrameStatsOverlay(bool show);
+	void SetFrameStatsOverlayKey(int key);
+
 	// Images / Textures
+
+	// Move-only pixel buffer.  Adopts memory allocated by an image decoder along with the function that frees
+	// it, so decoded pixels are never copied.  Without a deleter, it refers to memory owned by the caller, which
+	// must outlive it.  Accessors mirror std::vector.
+	class ImageData
+	{
+	public:
+		using Deleter = void (*)(void *);
+
+		ImageData() = default;
+		ImageData(uint8_t * data, size_t size, Deleter deleter = nullptr);
+		explicit ImageData(size_t size);
+		ImageData(ImageData && other) noexcept;
+		ImageData & operator = (ImageData && other) noexcept;
+		ImageData(const ImageData &) = delete;
+		ImageData & operator = (const ImageData &) = delete;
+		~ImageData();
+
+		uint8_t * data() { return m_data; }
+		const uint8_t * data() const { return m_data; }
+		size_t size() const { return m_size; }
+		bool empty() const { return m_size == 0; }
+		uint8_t * begin() { return m_data; }
+		uint8_t * end() { return m_data + m_size; }
+		const uint8_t * begin() const { return m_data; }
+		const uint8_t * end() const { return m_data + m_size; }
+		uint8_t & operator [] (size_t index) { return m_data[index]; }
+		const uint8_t & operator [] (size_t index) const { return m_data[index]; }
+
+	private:
+		void Release();
+
+		uint8_t * m_data = nullptr;
+		size_t m_size = 0;
+		Deleter m_deleter = nullptr;
+	};
+
 	struct ImageInfo
 	{
-		std::vector<uint8_t> data;
+		ImageData data;
 		int width{};
 		int height{};
 		int channels{};
@@ -159,9 +244,139 @@ namespace ImFrame
 		int width{};
 		int height{};
 	};
+
+	// Texture options - defaults match plain linear filtering with no mipmaps.  CPU mipmaps are downsampled
+	// with stb_image_resize (on worker threads when loading asynchronously), while GPU mipmaps are generated by
+	// the driver after upload.  Anisotropy is clamped to what the driver supports, and ignored without it.
+	enum class MipmapMode
+	{
+		None,
+		Gpu,
+		Cpu,
+	};
+	enum class TextureWrap
+	{
+		Clamp,
+		Repeat,
+		MirroredRepeat,
+	};
+	struct TextureOptions
+	{
+		MipmapMode mipmaps = MipmapMode::None;
+		float anisotropy = 1.0f;
+		TextureWrap wrapS = TextureWrap::Clamp;
+		TextureWrap wrapT = TextureWrap::Clamp;
+		bool linearFilter = true;
+	};
+
 	std::optional<ImageInfo> LoadImage(const char * filename);
-	std::optional<TextureInfo> LoadTexture(const char * filename);
-	std::optional<TextureInfo> LoadTexture(const ImageInfo& image);
+	std::optional<ImageInfo> LoadImage(const char * filename, uint8_t * buffer, size_t bufferSize);
+	std::optional<ImageInfo> GetImageInfo(const char * filename);
+	std::optional<TextureInfo> LoadTexture(const char * filename, const TextureOptions & options = TextureOptions());
+	std::optional<TextureInfo> LoadTexture(const ImageInfo& image, const TextureOptions & options = TextureOptions());
+
+	// Compressed textures - loads BC1, BC3 or BC7 blocks from DDS or KTX files, which use a quarter to an eighth
+	// of the memory of RGBA textures.  Blocks are decoded on the CPU where the driver doesn't support the format.
+	// Mipmaps are read from the file.  Create these files with the TextureConverter tool.
+	std::optional<TextureInfo> LoadCompressedTexture(const char * filename, const TextureOptions & options = TextureOptions());
+
+	// Asynchronous texture loading - images are decoded on worker threads, then uploaded on the main thread
+	// a limited number of bytes per frame.  The texture is a placeholder until loading completes, with width
+	// and height set once the image is decoded.  The GL texture is deleted along with the last handle.  An
+	// upload budget of zero means no limit, uploading each image in full the frame after it's decoded.
+	enum class LoadState
+	{
+		Pending,
+		Complete,
+		Failed,
+	};
+	struct AsyncTexture
+	{
+		~AsyncTexture();
+		LoadState state = LoadState::Pending;
+		TextureInfo texture;
+	};
+	using AsyncTexturePtr = std::shared_ptr<AsyncTexture>;
+	AsyncTexturePtr LoadTextureAsync(const char * filename, const TextureOptions & options = TextureOptions());
+	size_t GetTextureUploadBudget();
+	void SetTextureUploadBudget(size_t bytesPerFrame);
+
+	// Texture cache - handles loading the same file with the same options share one texture, deleted along with the last handle.
+	// Call UseCachedTexture() each frame the texture is drawn.  When cached textures exceed the GPU memory
+	// budget, those drawn least recently are evicted, and reload in the background when next used.
+	struct CachedTexture;
+	using CachedTexturePtr = std::shared_ptr<CachedTexture>;
+	CachedTexturePtr LoadCachedTexture(const char * filename, const TextureOptions & options = TextureOptions());
+	TextureInfo UseCachedTexture(const CachedTexturePtr & texture);
+	LoadState GetCachedTextureState(const CachedTexturePtr & texture);
+	size_t GetTextureCacheBudget();
+	void SetTextureCacheBudget(size_t bytes);
+	size_t GetTextureCacheSize();
+
+	// Tiled images - for images too large for a single texture.  A worker thread streams the image a strip of rows
+	// at a time into a mip pyramid of tiles, kept in a temporary file.  ImageView() then reads only the tiles
+	// visible at the current zoom into a shared GPU tile atlas, drawing coarser tiles until finer ones arrive.
+	// Drag to pan, scroll to zoom, and double-click to fit the image to the view.  ImageView() returns true when
+	// the view was panned or zoomed.  LoadTiledImage() decodes the whole file first, so is limited to 2 GB of
+	// RGBA pixels.  For larger images, pass a reader that fills rows of RGBA pixels from your own decoder.  Rows
+	// are read in order, each once, and returning false fails the load.
+	struct TiledImage;
+	using TiledImagePtr = std::shared_ptr<TiledImage>;
+	using ImageRowReader = std::function<bool(int firstRow, int rowCount, uint8_t * dest)>;
+	TiledImagePtr LoadTiledImage(const char * filename);
+	TiledImagePtr CreateTiledImage(ImageInfo && image);
+	TiledImagePtr CreateTiledImage(int width, int height, ImageRowReader reader);
+	LoadState GetTiledImageState(const TiledImagePtr & image);
+	bool ImageView(const char * label, const TiledImagePtr & image, const ImVec2 & size = ImVec2(0, 0));
+
+	// Non-owning view of contiguous values, like C++20's std::span
+	template<typename T>
+	class Span
+	{
+	public:
+		Span() = default;
+		Span(T * data, size_t size) : m_data(data), m_size(size) {}
+
+		T * data() const { return m_data; }
+		size_t size() const { return m_size; }
+		bool empty() const { return m_size == 0; }
+		T * begin() const { return m_data; }
+		T * end() const { return m_data + m_size; }
+		T & operator[](size_t index) const { return m_data[index]; }
+
+	private:
+		T * m_data = nullptr;
+		size_t m_size = 0;
+	};
+
+	// Tables - CSV or tab-delimited files, with column names in the first row and row names in the first column.
+	// The file is memory mapped, and text cells are views into it, valid for the life of the table, so loading
+	// takes little memory beyond the numeric values.  LoadTable() returns null if the file can't be parsed.
+	// Large files are parsed on all available cores, so quotes may only appear in quoted cells, escaped by doubling.
+	//
+	// Each column has a type inferred from its first rows, and numeric columns are stored contiguously, so they
+	// can be passed straight to ImPlot.  An integer column becomes floating point if any later cell has a
+	// fraction.  A column's span is empty unless it has the requested type.  Integers in a floating point column
+	// read as doubles, and cells that aren't numbers in a numeric column hold zero or NaN in the span, while
+	// GetTableCell() still returns their actual value.
+	using TableCell = std::variant<int64_t, double, std::string_view>;
+	enum class TableColumnType
+	{
+		Int,
+		Double,
+		String,
+	};
+	struct Table;
+	using TablePtr = std::shared_ptr<Table>;
+	TablePtr LoadTable(const char * filename);
+	size_t GetTableRowCount(const TablePtr & table);
+	size_t GetTableColumnCount(const TablePtr & table);
+	std::optional<size_t> FindTableRow(const TablePtr & table, std::string_view rowName);
+	std::optional<size_t> FindTableColumn(const TablePtr & table, std::string_view columnName);
+	TableCell GetTableCell(const TablePtr & table, size_t row, size_t column);
+	TableColumnType GetTableColumnType(const TablePtr & table, size_t column);
+	Span<const int64_t> GetTableIntColumn(const TablePtr & table, size_t column);
+	Span<const double> GetTableDoubleColumn(const TablePtr & table, size_t column);
 
 	// UI Fonts
 	enum class FontType
@@ -180,6 +395,24 @@ namespace ImFrame
 	float GetCustomFontSize();
 	void SetCustomFontSize(float pixelSize);
 
+	// Registered fonts are built into the same atlas as the UI font, so switching the UI font to one of them is
+	// instant, and several can be used at once with ImGui::PushFont(GetFont(...)).  Each new combination rebuilds
+	// the atlas in the background, so register fonts up front, such as in the app's constructor.  GetFont()
+	// returns null until then, and a rebuild invalidates previously returned fonts.
+	void RegisterFont(FontType font, float pixelSize);
+	ImFont * GetFont(FontType font, float pixelSize);
+
+	// Fonts are built with Latin glyphs only, and others are added to the atlas on demand before the next frame.
+	// Characters typed into ImGui are requested automatically, while text from elsewhere, such as loaded files,
+	// should be passed here as UTF-8 before it's displayed.  Until then, missing glyphs are drawn as '?'.
+	void RequestGlyphs(const char * text);
+
+	// Signed distance field fonts - each font type is rasterized once as distance fields, and drawn at any size
+	// by the renderer's SDF shader, so every registered size shares one small atlas and text stays sharp when
+	// scaled.  Small text is slightly softer than with regular fonts.  Toggling this rebuilds all fonts.
+	bool IsSdfFontEnabled();
+	void EnableSdfFont(bool enable);
+
 	// Persistent settings
 	std::string GetConfigValue(const char * sectionName, const char * valueName, const std::string & defaultValue);
 	float GetConfigValue(const char * sectionName, const char * valueName, float defaultValue);
@@ -192,6 +425,37 @@ namespace ImFrame
 	void SetConfigValue(const char * sectionName, const char * valueName, int value);
 	void SetConfigValue(const char * sectionName, const char * valueName, bool value);
 
+	// Config autosave - when enabled, changed settings are periodically written to disk on a worker thread, so
+	// they survive a crash.  Files are replaced in a single rename, never left partly written.  Settings are
+	// still saved on exit either way.
+	bool IsConfigAutosaveEnabled();
+	void EnableConfigAutosave(bool enable);
+	float GetConfigAutosaveInterval();
+	void SetConfigAutosaveInterval(float seconds);
+
+	// Config handles - the value's key is resolved once, and its value is cached once parsed, so reading config
+	// every frame is cheap.  Handles and the functions above share the same values, and setting one only marks
+	// its section as changed.  Create handles once the app is constructed, with any type GetConfigValue() takes.
+	struct ConfigValue;
+	template<typename T>
+	class ConfigHandle
+	{
+	public:
+		ConfigHandle() = default;
+		ConfigHandle(const char * sectionName, const char * valueName, const T & defaultValue);
+		const T & Get() const;
+		void Set(const T & value);
+
+	private:
+		ConfigValue * m_value = nullptr;
+		T m_default = T();
+	};
+	extern template class ConfigHandle<std::string>;
+	extern template class ConfigHandle<float>;
+	extern template class ConfigHandle<double>;
+	extern template class ConfigHandle<int>;
+	extern template class ConfigHandle<bool>;
+
     // ImGui / macOS native menu wrappers
     bool BeginMainMenuBar();
     void EndMainMenuBar();
@@ -24,12 +24,6 @@ THE SOFTWARE.
 
 #include "ImfInternal.h"
 
-#include "Fonts/CarlitoRegular.h"
-#include "Fonts/OpenSansRegular.h"
-#include "Fonts/OpenSansSemiBold.h"
-#include "Fonts/RobotoMedium.h"
-#include "Fonts/RobotoRegular.h"
-
 namespace ImFrame
 {
 	namespace
@@ -46,6 +40,16 @@ namespace ImFrame
 			}
 		};
 
+		// Font type and size combination built into the atlas.  The font is null until the next build.  Fonts
+		// not registered by the app are only kept while in use as the UI font.
+		struct RegisteredFont
+		{
+			FontType type;
+			float size;
+			bool registered;
+			ImFont * font;
+		};
+
 		// Persistent app data
 
 		struct PersistentData
@@ -64,21 +68,99 @@ namespace ImFrame
 			float fontSize = 15.0f;
 
 			// Settings for internal ImFrame data
-			mINI::INIStructure imframeIni;
+			Config imframeConfig;
 
 			// Settings for application data
-			mINI::INIStructure appIni;
+			Config appConfig;
+
+			// Config saving
+			std::filesystem::path configFolder;
+			bool configAutosaveEnabled = false;
+			float configAutosaveInterval = 5.0f;
+			double lastConfigAutosave = 0.0;
 
 			ImAppPtr appPtr;
 
 			bool fontChanged = true;
 			ImFont * customFont = nullptr;
+			std::vector<RegisteredFont> fonts;
+			FontAtlasBuildPtr fontBuild;
+			bool sdfFontEnabled = false;
+			ImFontAtlas * sdfFontAtlas = nullptr;
+			std::filesystem::path fontCacheFolder;
+
+			// Glyphs outside the default ranges, added to the atlas as they're requested
+			ImFontGlyphRangesBuilder glyphRequests;
+			bool glyphsRequested = false;
+			ImFontGlyphRangesBuilder knownGlyphs;
+			std::vector<ImWchar> extraGlyphs;
+			ImVector<ImWchar> fontGlyphRanges;
+			bool fontRebuild = false;
+
+			// Power saving data
+			bool powerSavingEnabled = false;
+			float minimumRefreshRate = 1.0f;
+			float displayRefreshRate = 60.0f;
+			int pendingFrames = 0;
+			double lastFrameTime = 0.0;
+			double skippedFrames = 0.0;
+			double waitTime = 0.0;
+			std::atomic<bool> redrawRequested = false;
+
+			// Application renders with OpenGL directly, so ImGui must save and restore GL state
+			bool rawGLEnabled = false;
+
+			// Frame statistics
+			FrameStats frameStats;
+			int frameStatsHistory = 300;
+			bool frameStatsOverlay = false;
+			int frameStatsOverlayKey = GLFW_KEY_F12;
+
+			// GPU timers for the main window and each secondary viewport
+			GpuTimer appGpuTimer;
+			GpuTimer imguiGpuTimer;
+			std::unordered_map<ImGuiID, GpuTimer> viewportGpuTimers;
+			float viewportGpuTime = 0.0f;
+			void (*rendererRenderWindow)(ImGuiViewport *, void *) = nullptr;
+			void (*rendererDestroyWindow)(ImGuiViewport *) = nullptr;
+		};
+
+		// Number of frames rendered after an input event, giving ImGui time to settle hover and layout state
+		const int PowerSavingEventFrames = 3;
+
+		// Frame phases displayed in the frame statistics overlay
+		struct FramePhase
+		{
+			const char * name;
+			float FrameTimings::* timing;
+		};
+		const FramePhase FramePhases[] =
+		{
+			{ "Events", &FrameTimings::events },
+			{ "Font Update", &FrameTimings::fontUpdate },
+			{ "Texture Uploads", &FrameTimings::textureUploads },
+			{ "New Frame", &FrameTimings::newFrame },
+			{ "App Update", &FrameTimings::appUpdate },
+			{ "Render", &FrameTimings::render },
+			{ "Render Draw Data", &FrameTimings::renderDrawData },
+			{ "Platform Windows", &FrameTimings::platformWindows },
+			{ "Swap Buffers", &FrameTimings::swapBuffers },
+			{ "App Update (GPU)", &FrameTimings::gpuAppUpdate },
+			{ "Render Draw Data (GPU)", &FrameTimings::gpuRenderDrawData },
+			{ "Platform Windows (GPU)", &FrameTimings::gpuPlatformWindows },
 		};
 
 
 		StaticInitializer s_initializer;
 		std::unique_ptr<PersistentData> s_data;
 
+		// App settings can be stored in a binary file, which loads faster when there are many of them
+#ifdef IMFRAME_BINARY_CONFIG
+		const char * AppConfigFileName = "app.cfg";
+#else
+		const char * AppConfigFileName = "app.ini";
+#endif
+
 
 		void ErrorCallback([[maybe_unused]] int error, const char * description)
 		{
@@ -87,6 +169,8 @@ namespace ImFrame
 
 		void KeyCallback([[maybe_unused]] GLFWwindow * window, int key, int scancode, int action, int mods)
 		{
+			if (action == GLFW_PRESS && key == s_data->frameStatsOverlayKey)
+				s_data->frameStatsOverlay = !s_data->frameStatsOverlay;
 			if (s_data->appPtr)
 			{
 				s_data->appPtr->OnKeyEvent(key, scancode, action, mods);
@@ -136,94 +220,89 @@ namespace ImFrame
 				s_data->appPtr->OnCursorPosition(x, y);
 		}
 
-		std::string GetConfigValue(mINI::INIStructure & ini, const char * sectionName, const char * valueName, const std::string & defaultValue)
+		template<typename T>
+		T GetConfigValue(Config & config, const char * sectionName, const char * valueName, const T & defaultValue)
 		{
-			const auto & s = ini[sectionName][valueName];
-			if (s.empty())
-				return defaultValue;
-			return s;
+			ConfigValue * value = config.FindValue(sectionName, valueName);
+			return value ? GetConfigValue(*value, defaultValue) : defaultValue;
 		}
 
-		float GetConfigValue(mINI::INIStructure & ini, const char * sectionName, const char * valueName, float defaultValue)
+		void GetConfig(Config & config, const std::string & fileName)
 		{
-			const auto & s = ini[sectionName][valueName];
-			if (s.empty())
-				return defaultValue;
-			return std::stof(s);
+			config.Read(s_data->configFolder / fileName);
 		}
 
-		double GetConfigValue(mINI::INIStructure & ini, const char * sectionName, const char * valueName, double defaultValue)
+		void GetImFrameConfig(Config & config)
 		{
-			const auto & s = ini[sectionName][valueName];
-			if (s.empty())
-				return defaultValue;
-			return std::stod(s);
+			GetConfig(config, "imframe.ini");
+			s_data->windowWidth = GetConfigValue(config, "window", "width", s_data->windowWidth);
+			s_data->windowHeight = GetConfigValue(config, "window", "height", s_data->windowHeight);
+			s_data->windowPosX = GetConfigValue(config, "window", "posx", s_data->windowPosX);
+			s_data->windowPosY = GetConfigValue(config, "window", "posy", s_data->windowPosY);
+			s_data->windowMaximized = GetConfigValue(config, "window", "maximized", s_data->windowMaximized);
+			s_data->backgroundColor[0] = GetConfigValue(config, "window", "bgcolorr", s_data->backgroundColor[0]);
+			s_data->backgroundColor[1] = GetConfigValue(config, "window", "bgcolorg", s_data->backgroundColor[1]);
+			s_data->backgroundColor[2] = GetConfigValue(config, "window", "bgcolorb", s_data->backgroundColor[2]);
+			s_data->fontEnabled = GetConfigValue(config, "font", "enabled", s_data->fontEnabled);
+			s_data->fontType = static_cast<ImFrame::FontType>(GetConfigValue(config, "font", "type", static_cast<int>(s_data->fontType)));
+			s_data->fontSize = GetConfigValue(config, "font", "size", s_data->fontSize);
 		}
 
-		int GetConfigValue(mINI::INIStructure & ini, const char * sectionName, const char * valueName, int defaultValue)
+		// Settings from an existing app.ini are imported when first switching to a binary file
+		void GetAppConfig(Config & config)
 		{
-			const auto & s = ini[sectionName][valueName];
-			if (s.empty())
-				return defaultValue;
-			return std::stoi(s);
-		}
-
-		bool GetConfigValue(mINI::INIStructure & ini, const char * sectionName, const char * valueName, bool defaultValue)
-		{
-			const auto & s = ini[sectionName][valueName];
-			if (s.empty())
-				return defaultValue;
-			return std::stoi(s) == 0 ? false : true;
+#ifdef IMFRAME_BINARY_CONFIG
+			config.SetFormat(ConfigFormat::Binary);
+			if (std::filesystem::exists(s_data->configFolder / AppConfigFileName))
+				GetConfig(config, AppConfigFileName);
+			else
+			{
+				GetConfig(config, "app.ini");
+				config.MarkDirty();
+			}
+#else
+			GetConfig(config, AppConfigFileName);
+#endif
 		}
 
-		void GetConfig(mINI::INIStructure & ini, const std::string & fileName, const std::string & orgName, const std::string & appName)
+		void SaveConfig(Config & config, const std::string & fileName)
 		{
-			namespace fs = std::filesystem;
-			fs::path configFolder = GetConfigFolder(orgName, appName);
-			configFolder.append(fileName);
-			mINI::INIFile file(configFolder.string());
-			file.read(ini);
+			config.Write(s_data->configFolder / fileName);
 		}
 
-		void GetImFrameConfig(mINI::INIStructure & ini, const std::string & orgName, const std::string & appName)
+		void UpdateImFrameConfig(Config & config)
 		{
-			GetConfig(ini, "imframe.ini", orgName, appName);
-			s_data->windowWidth = GetConfigValue(ini, "window", "width", s_data->windowWidth);
-			s_data->windowHeight = GetConfigValue(ini, "window", "height", s_data->windowHeight);
-			s_data->windowPosX = GetConfigValue(ini, "window", "posx", s_data->windowPosX);
-			s_data->windowPosY = GetConfigValue(ini, "window", "posy", s_data->windowPosY);
-			s_data->windowMaximized = GetConfigValue(ini, "window", "maximized", s_data->windowMaximized);
-			s_data->backgroundColor[0] = GetConfigValue(ini, "window", "bgcolorr", s_data->backgroundColor[0]);
-			s_data->backgroundColor[1] = GetConfigValue(ini, "window", "bgcolorg", s_data->backgroundColor[1]);
-			s_data->backgroundColor[2] = GetConfigValue(ini, "window", "bgcolorb", s_data->backgroundColor[2]);
-			s_data->fontEnabled = GetConfigValue(ini, "font", "enabled", s_data->fontEnabled);
-			s_data->fontType = static_cast<ImFrame::FontType>(GetConfigValue(ini, "font", "type", static_cast<int>(s_data->fontType)));
-			s_data->fontSize = GetConfigValue(ini, "font", "size", s_data->fontSize);
+			SetConfigValue(config.GetValue("window", "width"), s_data->windowWidth);
+			SetConfigValue(config.GetValue("window", "height"), s_data->windowHeight);
+			SetConfigValue(config.GetValue("window", "posx"), s_data->windowPosX);
+			SetConfigValue(config.GetValue("window", "posy"), s_data->windowPosY);
+			SetConfigValue(config.GetValue("window", "maximized"), s_data->windowMaximized);
+			SetConfigValue(config.GetValue("window", "bgcolorr"), s_data->backgroundColor[0]);
+			SetConfigValue(config.GetValue("window", "bgcolorg"), s_data->backgroundColor[1]);
+			SetConfigValue(config.GetValue("window", "bgcolorb"), s_data->backgroundColor[2]);
+			SetConfigValue(config.GetValue("font", "enabled"), s_data->fontEnabled);
+			SetConfigValue(config.GetValue("font", "type"), static_cast<int>(s_data->fontType));
+			SetConfigValue(config.GetValue("font", "size"), s_data->fontSize);
 		}
 
-		void SaveConfig(mINI::INIStructure & ini, const std::string & fileName, const std::string & orgName, const std::string & appName)
+		void SaveImFrameConfig(Config & config)
 		{
-			namespace fs = std::filesystem;
-			fs::path configFolder = GetConfigFolder(orgName, appName);
-			configFolder.append(fileName);
-			mINI::INIFile file(configFolder.string());
-			file.write(ini);
+			UpdateImFrameConfig(config);
+			SaveConfig(config, "imframe.ini");
 		}
 
-		void SaveImFrameConfig(mINI::INIStructure & ini, const std::string & orgName, const std::string & appName)
+		// Writes changed settings on a worker thread, skipping any file whose previous write is still in progress
+		void UpdateConfigAutosave()
 		{
-			ini["window"]["width"] = std::to_string(s_data->windowWidth);
-			ini["window"]["height"] = std::to_string(s_data->windowHeight);
-			ini["window"]["posx"] = std::to_string(s_data->windowPosX);
-			ini["window"]["posy"] = std::to_string(s_data->windowPosY);
-			ini["window"]["maximized"] = std::to_string(s_data->windowMaximized ? 1 : 0);
-			ini["window"]["bgcolorr"] = std::to_string(s_data->backgroundColor[0]);
-			ini["window"]["bgcolorg"] = std::to_string(s_data->backgroundColor[1]);
-			ini["window"]["bgcolorb"] = std::to_string(s_data->backgroundColor[2]);
-			ini["font"]["enabled"] = std::to_string(s_data->fontEnabled ? 1 : 0);
-			ini["font"]["type"] = std::to_string(static_cast<int>(s_data->fontType));
-			ini["font"]["size"] = std::to_string(s_data->fontSize);
-			SaveConfig(ini, "imframe.ini", orgName, appName);
+			if (!s_data->configAutosaveEnabled)
+				return;
+			const double now = glfwGetTime();
+			if (now - s_data->lastConfigAutosave < s_data->configAutosaveInterval)
+				return;
+			s_data->lastConfigAutosave = now;
+			UpdateImFrameConfig(s_data->imframeConfig);
+			s_data->imframeConfig.WriteAsync(s_data->configFolder / "imframe.ini");
+			s_data->appConfig.WriteAsync(s_data->configFolder / AppConfigFileName);
 		}
 
 		void OnExit()
@@ -236,39 +315,364 @@ namespace ImFrame
 #endif
 		}
 
-		void UpdateCustomFont()
+		void WaitForEvents()
 		{
-			if (!s_data->fontChanged)
+			s_data->waitTime = 0.0;
+
+			// Without power saving, or with frames still pending, we just poll and render at full rate
+			if (!s_data->powerSavingEnabled || s_data->pendingFrames > 0 || s_data->redrawRequested.exchange(false))
+			{
+				glfwPollEvents();
+				return;
+			}
+
+			// Sleep until an event arrives or the minimum refresh rate forces a new frame
+			const double waitStart = glfwGetTime();
+			const double deadline = s_data->lastFrameTime + 1.0 / static_cast<double>(s_data->minimumRefreshRate);
+			if (deadline <= waitStart)
+			{
+				glfwPollEvents();
+				return;
+			}
+			glfwWaitEventsTimeout(deadline - waitStart);
+			const double waitEnd = glfwGetTime();
+			s_data->waitTime = waitEnd - waitStart;
+
+			// Every display refresh we slept through is a frame we didn't have to render
+			s_data->skippedFrames += (waitEnd - waitStart) * static_cast<double>(s_data->displayRefreshRate);
+
+			// Waking before the deadline means we received an event (or a redraw request)
+			if (waitEnd < deadline)
+				s_data->pendingFrames = PowerSavingEventFrames;
+			s_data->redrawRequested = false;
+		}
+
+		bool IsImGuiAnimating()
+		{
+			// Active widgets, text carets, and held mouse buttons all need continuous frames
+			const ImGuiIO & io = ImGui::GetIO();
+			if (io.WantTextInput || ImGui::IsAnyItemActive())
+				return true;
+			for (bool down : io.MouseDown)
+			{
+				if (down)
+					return true;
+			}
+			return false;
+		}
+
+		void UpdatePendingFrames()
+		{
+			s_data->lastFrameTime = glfwGetTime();
+			if (s_data->pendingFrames > 0)
+				--s_data->pendingFrames;
+			if (IsImGuiAnimating())
+				s_data->pendingFrames = std::max(s_data->pendingFrames, 1);
+		}
+
+		void RenderWindowTimed(ImGuiViewport * viewport, void * renderArg)
+		{
+			// Each viewport renders with its own context, so each needs its own timer
+			auto & timer = s_data->viewportGpuTimers[viewport->ID];
+			timer.Begin();
+			s_data->rendererRenderWindow(viewport, renderArg);
+			timer.End();
+			s_data->viewportGpuTime += timer.GetMilliseconds();
+		}
+
+		void DestroyWindowTimed(ImGuiViewport * viewport)
+		{
+			// The viewport's queries are released along with its context, so just forget the timer
+			s_data->viewportGpuTimers.erase(viewport->ID);
+			if (s_data->rendererDestroyWindow)
+				s_data->rendererDestroyWindow(viewport);
+		}
+
+		void InitGpuTimers()
+		{
+			if (!IsGpuTimerSupported())
+				return;
+			ImGuiPlatformIO & platform_io = ImGui::GetPlatformIO();
+			if (!platform_io.Renderer_RenderWindow)
+				return;
+			s_data->rendererRenderWindow = platform_io.Renderer_RenderWindow;
+			s_data->rendererDestroyWindow = platform_io.Renderer_DestroyWindow;
+			platform_io.Renderer_RenderWindow = RenderWindowTimed;
+			platform_io.Renderer_DestroyWindow = DestroyWindowTimed;
+		}
+
+		void ShutDownGpuTimers()
+		{
+			ImGuiPlatformIO & platform_io = ImGui::GetPlatformIO();
+			if (s_data->rendererRenderWindow)
+			{
+				platform_io.Renderer_RenderWindow = s_data->rendererRenderWindow;
+				platform_io.Renderer_DestroyWindow = s_data->rendererDestroyWindow;
+			}
+			s_data->appGpuTimer.Destroy();
+			s_data->imguiGpuTimer.Destroy();
+		}
+
+		void RecordFrameTimings(const FrameTimings & timings)
+		{
+			auto & stats = s_data->frameStats;
+			const size_t history = static_cast<size_t>(s_data->frameStatsHistory);
+			if (stats.frames.size() < history)
+			{
+				stats.frames.push_back(timings);
+			}
+			else
+			{
+				stats.frames[stats.offset] = timings;
+				stats.offset = (stats.offset + 1) % s_data->frameStatsHistory;
+			}
+			++stats.frameCount;
+			stats.skippedFrames = static_cast<uint64_t>(s_data->skippedFrames);
+		}
+
+		void DrawFrameStatsOverlay()
+		{
+			if (!s_data->frameStatsOverlay)
+				return;
+			const auto & stats = s_data->frameStats;
+			if (stats.frames.empty())
 				return;
-			if (s_data->fontEnabled)
+
+			const ImGuiViewport * main_viewport = ImGui::GetMainViewport();
+			ImGui::SetNextWindowPos(ImVec2(main_viewport->WorkPos.x + 50, main_viewport->WorkPos.y + 50), ImGuiCond_FirstUseEver);
+			ImGui::SetNextWindowSize(ImVec2(500, 450), ImGuiCond_FirstUseEver);
+			if (!ImGui::Begin("Frame Statistics", &s_data->frameStatsOverlay))
 			{
-				ImGuiIO & io = ImGui::GetIO();
-				if (s_data->customFont)
-					io.Fonts->Clear();
-				switch (s_data->fontType)
+				ImGui::End();
+				return;
+			}
+
+			// Gather averages and peaks over the history buffer
+			const int count = static_cast<int>(stats.frames.size());
+			std::array<float, std::size(FramePhases)> average = {};
+			std::array<float, std::size(FramePhases)> peak = {};
+			float averageTotal = 0.0f;
+			for (const auto & frame : stats.frames)
+			{
+				for (size_t i = 0; i < std::size(FramePhases); ++i)
+				{
+					const float timing = frame.*FramePhases[i].timing;
+					average[i] += timing;
+					peak[i] = std::max(peak[i], timing);
+				}
+				averageTotal += frame.total;
+			}
+			for (auto & a : average)
+				a /= static_cast<float>(count);
+			averageTotal /= static_cast<float>(count);
+			const FrameTimings & latest = stats.frames[(stats.offset + count - 1) % count];
+
+			ImGui::Text("Frame: %.2f ms avg, %.2f ms last", averageTotal, latest.total);
+			ImGui::Text("Frames rendered: %llu, skipped: %llu", static_cast<unsigned long long>(stats.frameCount), static_cast<unsigned long long>(stats.skippedFrames));
+
+			if (ImGui::BeginTable("##FramePhases", 4, ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV))
+			{
+				ImGui::TableSetupColumn("Phase");
+				ImGui::TableSetupColumn("Last (ms)");
+				ImGui::TableSetupColumn("Avg (ms)");
+				ImGui::TableSetupColumn("Max (ms)");
+				ImGui::TableHeadersRow();
+				for (size_t i = 0; i < std::size(FramePhases); ++i)
 				{
-					case FontType::CarlitoRegular:
-						s_data->customFont = io.Fonts->AddFontFromMemoryCompressedTTF((void *)(&CarlitoRegular_compressed_data[0]), CarlitoRegular_compressed_size, s_data->fontSize);
-						break;
-					case FontType::OpenSansRegular:
-						s_data->customFont = io.Fonts->AddFontFromMemoryCompressedTTF((void *)(&OpenSansRegular_compressed_data[0]), OpenSansRegular_compressed_size, s_data->fontSize);
-						break;
-					case FontType::OpenSansSemiBold:
-						s_data->customFont = io.Fonts->AddFontFromMemoryCompressedTTF((void *)(&OpenSansSemiBold_compressed_data[0]), OpenSansSemiBold_compressed_size, s_data->fontSize);
-						break;
-					case FontType::RobotoMedium:
-						s_data->customFont = io.Fonts->AddFontFromMemoryCompressedTTF((void *)(&RobotoMedium_compressed_data[0]), RobotoMedium_compressed_size, s_data->fontSize);
-						break;
-					case FontType::RobotoRegular:
-						s_data->customFont = io.Fonts->AddFontFromMemoryCompressedTTF((void *)(&RobotoRegular_compressed_data[0]), RobotoRegular_compressed_size, s_data->fontSize);
-						break;
+					ImGui::TableNextRow();
+					ImGui::TableNextColumn();
+					ImGui::TextUnformatted(FramePhases[i].name);
+					ImGui::TableNextColumn();
+					ImGui::Text("%.3f", latest.*FramePhases[i].timing);
+					ImGui::TableNextColumn();
+					ImGui::Text("%.3f", average[i]);
+					ImGui::TableNextColumn();
+					ImGui::Text("%.3f", peak[i]);
 				}
+				ImGui::EndTable();
+			}
+
+			// Plot directly from the ring buffer, using the offset and stride to walk each timing field
+			if (ImPlot::BeginPlot("##FrameTimes", ImVec2(-1, -1), ImPlotFlags_NoMouseText))
+			{
+				ImPlot::SetupAxes("Frame", "ms", ImPlotAxisFlags_AutoFit, ImPlotAxisFlags_AutoFit);
+				ImPlot::PlotLine("Total", &stats.frames[0].total, count, 1.0, 0.0, 0, stats.offset, sizeof(FrameTimings));
+				for (const auto & phase : FramePhases)
+					ImPlot::PlotLine(phase.name, &(stats.frames[0].*phase.timing), count, 1.0, 0.0, 0, stats.offset, sizeof(FrameTimings));
+				ImPlot::EndPlot();
+			}
+			ImGui::End();
+		}
+
+		RegisteredFont * FindFont(FontType type, float size)
+		{
+			for (auto & font : s_data->fonts)
+			{
+				if (font.type == type && font.size == size)
+					return &font;
+			}
+			return nullptr;
+		}
+
+		// Adds extra glyphs from first onward to an atlas, growing it if they don't fit, and uploads just the area
+		// they went into if its texture already exists.  Returns false if the atlas can't grow any further.
+		bool AddExtraGlyphs(ImFontAtlas * atlas, bool sdf, size_t first)
+		{
+			const ImWchar * codepoints = s_data->extraGlyphs.data() + first;
+			const size_t count = s_data->extraGlyphs.size() - first;
+			AtlasRegion dirty;
+			bool grown = false;
+			bool complete = BakeGlyphs(atlas, codepoints, count, sdf, dirty);
+			while (!complete && GrowFontAtlas(atlas))
+			{
+				grown = true;
+				complete = BakeGlyphs(atlas, codepoints, count, sdf, dirty);
+			}
+			if (atlas->TexID == 0)
+				return complete;
+			if (grown && sdf)
+				ImGui_ImplOpenGL3_CreateSdfFontsTexture(atlas);
+			else if (grown)
+			{
+				ImGui_ImplOpenGL3_DestroyFontsTexture();
 				ImGui_ImplOpenGL3_CreateFontsTexture();
 			}
-			else
+			else if (!dirty.IsEmpty())
+				ImGui_ImplOpenGL3_UpdateFontsTexture(atlas, dirty.x0, dirty.y0, dirty.x1 - dirty.x0, dirty.y1 - dirty.y0);
+			return complete;
+		}
+
+		// Glyphs for the SDF fonts only go in their atlas, since ImGui's default font has nothing past Latin
+		void AddExtraGlyphs(size_t first)
+		{
+			if (first >= s_data->extraGlyphs.size())
+				return;
+			const bool sdf = s_data->sdfFontAtlas != nullptr;
+			if (!AddExtraGlyphs(sdf ? s_data->sdfFontAtlas : ImGui::GetIO().Fonts, sdf, first))
 			{
-				s_data->customFont = nullptr;
+				s_data->fontRebuild = true;
+				s_data->fontChanged = true;
+			}
+		}
+
+		// Replaces ImGui's atlas between frames, along with its texture if it's already been uploaded.  Otherwise
+		// the renderer uploads it along with its other device objects on the first frame.  The SDF atlas isn't
+		// ImGui's, so it's always uploaded here.
+		void SwapFontAtlas(FontAtlasBuild & build)
+		{
+			ImGuiIO & io = ImGui::GetIO();
+			const bool uploaded = io.Fonts->TexID != 0;
+			if (uploaded)
+				ImGui_ImplOpenGL3_DestroyFontsTexture();
+			IM_DELETE(io.Fonts);
+			io.Fonts = std::exchange(build.atlas, nullptr);
+			if (s_data->sdfFontAtlas)
+			{
+				ImGui_ImplOpenGL3_DestroySdfFontsTexture();
+				IM_DELETE(s_data->sdfFontAtlas);
 			}
+			s_data->sdfFontAtlas = std::exchange(build.sdfAtlas, nullptr);
+			for (auto & font : s_data->fonts)
+				font.font = build.FindFont(font.type, font.size);
+			s_data->fontGlyphRanges.swap(build.glyphRanges);
+			s_data->fontRebuild = false;
+			if (uploaded)
+				ImGui_ImplOpenGL3_CreateFontsTexture();
+			if (s_data->sdfFontAtlas)
+				ImGui_ImplOpenGL3_CreateSdfFontsTexture(s_data->sdfFontAtlas);
+
+			// Glyphs requested while this atlas was being built
+			AddExtraGlyphs(build.extraGlyphs.size());
+		}
+
+		// The atlas starts with ImGui's default font, used while the custom font is disabled, followed by every
+		// registered font.  The first atlas is built right away, so the first frame has the right font.  Later
+		// ones are built on a worker thread while the current atlas stays in use, ahead of other background work
+		// so a font change doesn't wait for queued image loads.
+		void BuildFonts()
+		{
+			auto build = std::make_shared<FontAtlasBuild>();
+			build->sdf = s_data->sdfFontEnabled;
+			build->extraGlyphs = s_data->extraGlyphs;
+			for (const auto & font : s_data->fonts)
+				build->requested.emplace_back(font.type, font.size);
+			if (ImGui::GetIO().Fonts->Fonts.empty())
+			{
+				BuildEmbeddedFonts(*build, s_data->fontCacheFolder);
+				SwapFontAtlas(*build);
+				return;
+			}
+			s_data->fontBuild = build;
+			GetThreadPool().EnqueuePriority([build, cacheFolder = s_data->fontCacheFolder] ()
+			{
+				BuildEmbeddedFonts(*build, cacheFolder);
+				build->complete = true;
+				RequestRedraw();
+			});
+		}
+
+		// Glyphs requested during the last frame are baked into the current atlas before the next one, and
+		// remembered for every atlas built after it
+		void UpdateGlyphs()
+		{
+			if (!s_data->glyphsRequested)
+				return;
+			s_data->glyphsRequested = false;
+			ImVector<ImWchar> ranges;
+			s_data->glyphRequests.BuildRanges(&ranges);
+			s_data->glyphRequests.Clear();
+			const size_t first = s_data->extraGlyphs.size();
+			for (int i = 0; i + 1 < ranges.Size; i += 2)
+			{
+				for (unsigned int codepoint = ranges[i]; codepoint <= ranges[i + 1]; ++codepoint)
+				{
+					if (codepoint < 0x100 || s_data->knownGlyphs.GetBit(codepoint))
+						continue;
+					s_data->knownGlyphs.SetBit(codepoint);
+					s_data->extraGlyphs.push_back(static_cast<ImWchar>(codepoint));
+				}
+			}
+			if (!ImGui::GetIO().Fonts->Fonts.empty())
+				AddExtraGlyphs(first);
+		}
+
+		// Switching to a font already in the atlas is instant.  Only new combinations rebuild it.
+		void UpdateCustomFont()
+		{
+			// Swap in an atlas finished in the background, unless fonts it lacks or a different mode were
+			// requested meanwhile, in which case the current atlas stays until a complete one is built
+			if (s_data->fontBuild && s_data->fontBuild->complete)
+			{
+				auto build = std::move(s_data->fontBuild);
+				auto missing = std::find_if(s_data->fonts.begin(), s_data->fonts.end(), [&build] (const RegisteredFont & font)
+				{
+					return !build->FindFont(font.type, font.size);
+				});
+				if (missing == s_data->fonts.end() && build->sdf == s_data->sdfFontEnabled)
+					SwapFontAtlas(*build);
+				s_data->fontChanged = true;
+			}
+			UpdateGlyphs();
+			if (!s_data->fontChanged)
+				return;
+
+			// Drop previous UI fonts, so the atlas doesn't grow with every size tried
+			auto unused = std::remove_if(s_data->fonts.begin(), s_data->fonts.end(), [] (const RegisteredFont & font)
+			{
+				return !font.registered && (font.type != s_data->fontType || font.size != s_data->fontSize);
+			});
+			s_data->fonts.erase(unused, s_data->fonts.end());
+			if (s_data->fontEnabled && !FindFont(s_data->fontType, s_data->fontSize))
+				s_data->fonts.push_back({ s_data->fontType, s_data->fontSize, false, nullptr });
+			auto unbuilt = std::find_if(s_data->fonts.begin(), s_data->fonts.end(), [] (const RegisteredFont & font) { return !font.font; });
+			if ((unbuilt != s_data->fonts.end() || s_data->fontRebuild) && !s_data->fontBuild)
+				BuildFonts();
+
+			// Keep the previous UI font until its replacement is built
+			if (!s_data->fontEnabled)
+				s_data->customFont = nullptr;
+			else if (ImFont * font = FindFont(s_data->fontType, s_data->fontSize)->font)
+				s_data->customFont = font;
 			s_data->fontChanged = false;
 		}
 	}
@@ -392,54 +796,76 @@ namespace ImFrame
         return s_data->backgroundColor;
     }
 
-	// Simple helper function to load an image from disk
-	std::optional<ImageInfo> LoadImage(const char* filename)
-	{
-		// Load from file
-		ImageInfo image;
-		unsigned char* image_data = stbi_load(filename, &image.width, &image.height, NULL, 4);
-		if (image_data == NULL)
-			return std::optional<ImageInfo>();
-		image.channels = 4;
-		uint8_t * bytes = reinterpret_cast<uint8_t*>(image_data);
-		size_t size = static_cast<size_t>(image.width * image.height * image.channels);
-		image.data.reserve(size);
-		std::copy(bytes, &bytes[size], std::back_inserter(image.data));
-		stbi_image_free(image_data);
-		return image;
-	}
-
-	// Simple helper function to load an image from disk into a OpenGL texture with common settings
-	std::optional<TextureInfo> LoadTexture(const char * filename)
-	{
-		auto image = LoadImage(filename);
-		if (!image)
-			return std::optional<TextureInfo>();
-		return LoadTexture(image.value());
-	}
-
-	// Simple helper function to load an image into a OpenGL texture with common settings
-	std::optional<TextureInfo> LoadTexture(const ImageInfo& image)
-	{
-		// Create a OpenGL texture identifier
-		GLuint image_texture;
-		glGenTextures(1, &image_texture);
-		glBindTexture(GL_TEXTURE_2D, image_texture);
-
-		// Setup filtering parameters for display
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE); // This is required on WebGL for non power-of-two textures
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE); // Same
-
-		// Upload pixels into texture
-#if defined(GL_UNPACK_ROW_LENGTH) && !defined(__EMSCRIPTEN__)
-		glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
-#endif
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, image.width, image.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, static_cast<const void *>(image.data.data()));
+	bool IsRawGLEnabled()
+	{
+		return s_data->rawGLEnabled;
+	}
+
+	void EnableRawGL(bool enable)
+	{
+		s_data->rawGLEnabled = enable;
+	}
+
+	bool IsPowerSavingEnabled()
+	{
+		return s_data->powerSavingEnabled;
+	}
+
+	void EnablePowerSaving(bool enable)
+	{
+		s_data->powerSavingEnabled = enable;
+	}
 
-		return TextureInfo{ image_texture, image.width, image.height };
+	float GetMinimumRefreshRate()
+	{
+		return s_data->minimumRefreshRate;
+	}
 
+	void SetMinimumRefreshRate(float framesPerSecond)
+	{
+		assert(framesPerSecond > 0.0f);
+		s_data->minimumRefreshRate = framesPerSecond;
+	}
+
+	void RequestRedraw()
+	{
+		s_data->redrawRequested = true;
+		glfwPostEmptyEvent();
+	}
+
+	uint64_t GetSkippedFrameCount()
+	{
+		return static_cast<uint64_t>(s_data->skippedFrames);
+	}
+
+	const FrameStats & GetFrameStats()
+	{
+		return s_data->frameStats;
+	}
+
+	void SetFrameStatsHistory(int frameCount)
+	{
+		assert(frameCount > 0);
+		if (frameCount == s_data->frameStatsHistory)
+			return;
+		s_data->frameStatsHistory = frameCount;
+		s_data->frameStats.frames.clear();
+		s_data->frameStats.offset = 0;
+	}
+
+	bool IsFrameStatsOverlayVisible()
+	{
+		return s_data->frameStatsOverlay;
+	}
+
+	void ShowFrameStatsOverlay(bool show)
+	{
+		s_data->frameStatsOverlay = show;
+	}
+
+	void SetFrameStatsOverlayKey(int key)
+	{
+		s_data->frameStatsOverlayKey = key;
 	}
 
 	bool IsCustomFontEnabled()
@@ -484,56 +910,143 @@ namespace ImFrame
 		}
 	}
 
+	void RegisterFont(FontType font, float pixelSize)
+	{
+		if (auto registered = FindFont(font, pixelSize))
+			registered->registered = true;
+		else
+		{
+			s_data->fonts.push_back({ font, pixelSize, true, nullptr });
+			s_data->fontChanged = true;
+		}
+	}
+
+	ImFont * GetFont(FontType font, float pixelSize)
+	{
+		auto registered = FindFont(font, pixelSize);
+		return registered ? registered->font : nullptr;
+	}
+
+	void RequestGlyphs(const char * text)
+	{
+		s_data->glyphRequests.AddText(text);
+		s_data->glyphsRequested = true;
+	}
+
+	bool IsSdfFontEnabled()
+	{
+		return s_data->sdfFontEnabled;
+	}
+
+	void EnableSdfFont(bool enable)
+	{
+		if (enable == s_data->sdfFontEnabled)
+			return;
+		s_data->sdfFontEnabled = enable;
+		s_data->fontChanged = true;
+
+		// Every font needs rebuilding, though the current ones stay in use until then
+		for (auto & font : s_data->fonts)
+			font.font = nullptr;
+	}
+
 	std::string GetConfigValue(const char * sectionName, const char * valueName, const std::string & defaultValue)
 	{
-		return GetConfigValue(s_data->appIni, sectionName, valueName, defaultValue);
+		return GetConfigValue(s_data->appConfig, sectionName, valueName, defaultValue);
 	}
 
 	float GetConfigValue(const char * sectionName, const char * valueName, float defaultValue)
 	{
-		return GetConfigValue(s_data->appIni, sectionName, valueName, defaultValue);
+		return GetConfigValue(s_data->appConfig, sectionName, valueName, defaultValue);
 	}
 
 	double GetConfigValue(const char * sectionName, const char * valueName, double defaultValue)
 	{
-		return GetConfigValue(s_data->appIni, sectionName, valueName, defaultValue);
+		return GetConfigValue(s_data->appConfig, sectionName, valueName, defaultValue);
 	}
 
 	int GetConfigValue(const char * sectionName, const char * valueName, int defaultValue)
 	{
-		return GetConfigValue(s_data->appIni, sectionName, valueName, defaultValue);
+		return GetConfigValue(s_data->appConfig, sectionName, valueName, defaultValue);
 	}
 
 	bool GetConfigValue(const char * sectionName, const char * valueName, bool defaultValue)
 	{
-		return GetConfigValue(s_data->appIni, sectionName, valueName, defaultValue);
+		return GetConfigValue(s_data->appConfig, sectionName, valueName, defaultValue);
 	}
 
 	void SetConfigValue(const char * sectionName, const char * valueName, const std::string & value)
 	{
-		s_data->appIni[sectionName][valueName] = value;
+		SetConfigValue(s_data->appConfig.GetValue(sectionName, valueName), value);
 	}
 
 	void SetConfigValue(const char * sectionName, const char * valueName, float value)
 	{
-		s_data->appIni[sectionName][valueName] = std::to_string(value);
+		SetConfigValue(s_data->appConfig.GetValue(sectionName, valueName), value);
 	}
 
 	void SetConfigValue(const char * sectionName, const char * valueName, double value)
 	{
-		s_data->appIni[sectionName][valueName] = std::to_string(value);
+		SetConfigValue(s_data->appConfig.GetValue(sectionName, valueName), value);
 	}
 
 	void SetConfigValue(const char * sectionName, const char * valueName, int value)
 	{
-		s_data->appIni[sectionName][valueName] = std::to_string(value);
+		SetConfigValue(s_data->appConfig.GetValue(sectionName, valueName), value);
 	}
 
 	void SetConfigValue(const char * sectionName, const char * valueName, bool value)
 	{
-		s_data->appIni[sectionName][valueName] = value ? "1" : "0";
+		SetConfigValue(s_data->appConfig.GetValue(sectionName, valueName), value);
+	}
+
+	bool IsConfigAutosaveEnabled()
+	{
+		return s_data->configAutosaveEnabled;
 	}
 
+	void EnableConfigAutosave(bool enable)
+	{
+		s_data->configAutosaveEnabled = enable;
+	}
+
+	float GetConfigAutosaveInterval()
+	{
+		return s_data->configAutosaveInterval;
+	}
+
+	void SetConfigAutosaveInterval(float seconds)
+	{
+		assert(seconds > 0.0f);
+		s_data->configAutosaveInterval = seconds;
+	}
+
+	template<typename T>
+	ConfigHandle<T>::ConfigHandle(const char * sectionName, const char * valueName, const T & defaultValue) :
+		m_value(&s_data->appConfig.GetValue(sectionName, valueName)),
+		m_default(defaultValue)
+	{
+	}
+
+	template<typename T>
+	const T & ConfigHandle<T>::Get() const
+	{
+		return m_value ? GetConfigValue(*m_value, m_default) : m_default;
+	}
+
+	template<typename T>
+	void ConfigHandle<T>::Set(const T & value)
+	{
+		if (m_value)
+			SetConfigValue(*m_value, value);
+	}
+
+	template class ConfigHandle<std::string>;
+	template class ConfigHandle<float>;
+	template class ConfigHandle<double>;
+	template class ConfigHandle<int>;
+	template class ConfigHandle<bool>;
+
 
     bool BeginMainMenuBar()
     {
@@ -621,8 +1134,9 @@ namespace ImFrame
 #endif
 
 		// Read existing config data
-		GetImFrameConfig(s_data->imframeIni, orgName, appName);
-		GetConfig(s_data->appIni, "app.ini", orgName, appName);
+		s_data->configFolder = GetConfigFolder(orgName, appName);
+		GetImFrameConfig(s_data->imframeConfig);
+		GetAppConfig(s_data->appConfig);
 
 		// Init GLFW and create window
 		glfwSetErrorCallback(ErrorCallback);
@@ -654,6 +1168,13 @@ namespace ImFrame
 		glfwMakeContextCurrent(window);
 		glfwSwapInterval(1);
 
+		// Use the monitor refresh rate to estimate frames skipped while power saving
+		if (const GLFWvidmode * mode = glfwGetVideoMode(glfwGetPrimaryMonitor()))
+		{
+			if (mode->refreshRate > 0)
+				s_data->displayRefreshRate = static_cast<float>(mode->refreshRate);
+		}
+
 		// Initialize glad GL functions
 		gladLoadGL();
 
@@ -674,7 +1195,10 @@ namespace ImFrame
 		io.IniFilename = iniStr.c_str();
 		ImGui_ImplGlfw_InitForOpenGL(window, true);
 		ImGui_ImplOpenGL3_Init();
-		ImGui_ImplOpenGL3_CreateFontsTexture();
+		InitGpuTimers();
+
+		// Built font atlases are cached, since rasterizing them slows down every startup
+		s_data->fontCacheFolder = GetConfigFolder(orgName, appName) / "FontCache";
 
 		// Initialize ImPlot
 		ImPlot::CreateContext();
@@ -685,16 +1209,46 @@ namespace ImFrame
 		// Main application loop
 		while (!glfwWindowShouldClose(window))
 		{
-			// Perform event and input polling
-			glfwPollEvents();
+			// Track CPU time spent in each phase of the frame
+			FrameTimings timings;
+			double frameStart = glfwGetTime();
+			double phaseStart = frameStart;
+			auto EndPhase = [&phaseStart] (float & timing)
+			{
+				const double now = glfwGetTime();
+				timing = static_cast<float>((now - phaseStart) * 1000.0);
+				phaseStart = now;
+			};
+
+			// Perform event and input polling, or wait for events in power saving mode
+			WaitForEvents();
+			frameStart += s_data->waitTime;
+			phaseStart += s_data->waitTime;
+			EndPhase(timings.events);
 
 			// Load new font if necessary
 			UpdateCustomFont();
+			EndPhase(timings.fontUpdate);
+
+			// Upload textures loaded in the background
+			UpdateTextures();
+			EndPhase(timings.textureUploads);
 
 			// Start the Dear ImGui frame
 			ImGui_ImplOpenGL3_NewFrame();
 			ImGui_ImplGlfw_NewFrame();
 			ImGui::NewFrame();
+			EndPhase(timings.newFrame);
+
+			// Characters typed this frame may be outside the glyph ranges built so far
+			for (ImWchar character : io.InputQueueCharacters)
+			{
+				if (character >= 0x100)
+				{
+					s_data->glyphRequests.AddChar(character);
+					s_data->glyphsRequested = true;
+				}
+			}
 
 			// Use custom font for this frame
 			ImFont * font = s_data->customFont;
@@ -709,19 +1263,31 @@ namespace ImFrame
 			glClear(GL_COLOR_BUFFER_BIT);
 
 			// Perform app-specific updates
+			s_data->appGpuTimer.Begin();
 			s_data->appPtr->OnUpdate();
+			s_data->appGpuTimer.End();
+
+			// Display frame statistics if requested
+			DrawFrameStatsOverlay();
 
 			// Pop custom font at the end of the frame
 			if (font)
 				ImGui::PopFont();
+			EndPhase(timings.appUpdate);
 
 			// Render ImGui to draw data
 			ImGui::Render();
+			EndPhase(timings.render);
 
-			// Render ImGui
+			// Render ImGui, only saving and restoring GL state if the app renders with GL itself
+			ImGui_ImplOpenGL3_SetBackupState(s_data->rawGLEnabled);
+			s_data->imguiGpuTimer.Begin();
 			ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+			s_data->imguiGpuTimer.End();
+			EndPhase(timings.renderDrawData);
 
 			// Update and Render additional Platform Windows
+			s_data->viewportGpuTime = 0.0f;
 			if (io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable)
 			{
 				GLFWwindow * backup_current_context = glfwGetCurrentContext();
@@ -729,9 +1295,24 @@ namespace ImFrame
 				ImGui::RenderPlatformWindowsDefault();
 				glfwMakeContextCurrent(backup_current_context);
 			}
+			EndPhase(timings.platformWindows);
             
 			// Present buffer
 			glfwSwapBuffers(window);
+			EndPhase(timings.swapBuffers);
+
+			// Record timings for this frame
+			timings.total = static_cast<float>((phaseStart - frameStart) * 1000.0);
+			timings.gpuAppUpdate = s_data->appGpuTimer.GetMilliseconds();
+			timings.gpuRenderDrawData = s_data->imguiGpuTimer.GetMilliseconds();
+			timings.gpuPlatformWindows = s_data->viewportGpuTime;
+			RecordFrameTimings(timings);
+
+			// Determine whether more frames are needed when power saving
+			UpdatePendingFrames();
+
+			// Save changed settings in the background
+			UpdateConfigAutosave();
 		}
         
         // OS-specific shutdown
@@ -740,11 +1321,15 @@ namespace ImFrame
 		// Delete application
 		s_data->appPtr = nullptr;
 
-		// Save config data to disk
-		SaveConfig(s_data->appIni, "app.ini", orgName, appName);
-		SaveImFrameConfig(s_data->imframeIni, orgName, appName);
+		// Save config data to disk, after any autosave still in progress
+		SaveConfig(s_data->appConfig, AppConfigFileName);
+		SaveImFrameConfig(s_data->imframeConfig);
 
 		// Shut down ImGui and ImPlot
+		ShutDownGpuTimers();
+		ShutDownThreadPool();
+		ShutDownTextures();
+		ShutDownTiledImages();
 		ImGui_ImplOpenGL3_DestroyFontsTexture();
 		ImGui_ImplGlfw_Shutdown();
 		ImGui_ImplOpenGL3_Shutdown();
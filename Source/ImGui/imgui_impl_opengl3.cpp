@@ -15,6 +15,10 @@
 
 // CHANGELOG
 // (minor and older changes stripped away, please see git history for details)
+//  2022-XX-XX: OpenGL: Added ImGui_ImplOpenGL3_UpdateFontsTexture() to upload only the part of a font atlas that changed, e.g. after adding glyphs to it.
+//  2022-XX-XX: OpenGL: Added ImGui_ImplOpenGL3_CreateSdfFontsTexture() for a second font atlas of signed distance fields, thresholded in the fragment shader when its texture is bound.
+//  2022-XX-XX: OpenGL: Added ImGui_ImplOpenGL3_SetBackupState() and ImGui_ImplOpenGL3_InvalidateStateCache(). Track the GL state we set per context to skip redundant texture binds and scissor changes, and skip the full backup/restore when the application doesn't touch GL itself.
+//  2022-XX-XX: OpenGL: Use the glad loader when IMGUI_IMPL_OPENGL_LOADER_GLAD is defined. Stream all draw lists through a single ring buffer (persistently mapped when GL_ARB_buffer_storage is available) and draw with base vertex offsets.
 //  2022-XX-XX: Platform: Added support for multiple windows via the ImGuiPlatformIO interface.
 //  2022-05-23: OpenGL: Reworking 2021-12-15 "Using buffer orphaning" so it only happens on Intel GPU, seems to cause problems otherwise. (#4468, #4825, #4832, #5127).
 //  2022-05-13: OpenGL: Fix state corruption on OpenGL ES 2.0 due to not preserving GL_ELEMENT_ARRAY_BUFFER_BINDING and vertex attribute states.
@@ -132,6 +136,8 @@
 #else
 #include <GLES3/gl3.h>          // Use GL ES 3
 #endif
+#elif defined(IMGUI_IMPL_OPENGL_LOADER_GLAD)
+#include <glad/glad.h>          // Share the application's glad loader, which exposes the full GL 4.1 API plus extensions
 #elif !defined(IMGUI_IMPL_OPENGL_LOADER_CUSTOM)
 // Modern desktop OpenGL doesn't have a standard portable header file to load OpenGL function pointers.
 // Helper libraries are often used for this purpose! Here we are using our own minimal custom loader based on gl3w.
@@ -175,20 +181,58 @@
 #define IMGUI_IMPL_OPENGL_MAY_HAVE_PRIMITIVE_RESTART
 #endif
 
+// Desktop GL 3.2+ has fences and glMapBufferRange(), allowing all draw lists to be streamed through a single buffer.
+// Loaders without these symbols (such as our stripped gl3w loader) fall back to uploading each draw list separately.
+#if defined(IMGUI_IMPL_OPENGL_MAY_HAVE_VTX_OFFSET) && defined(GL_MAP_UNSYNCHRONIZED_BIT) && defined(GL_SYNC_GPU_COMMANDS_COMPLETE)
+#define IMGUI_IMPL_OPENGL_MAY_HAVE_STREAMING
+#endif
+
+// Desktop GL 4.4+ or GL_ARB_buffer_storage allows the streaming buffer to stay persistently mapped
+#if defined(IMGUI_IMPL_OPENGL_MAY_HAVE_STREAMING) && defined(GL_MAP_PERSISTENT_BIT)
+#define IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+#endif
+
 // Desktop GL use extension detection
 #if !defined(IMGUI_IMPL_OPENGL_ES2) && !defined(IMGUI_IMPL_OPENGL_ES3)
 #define IMGUI_IMPL_OPENGL_MAY_HAVE_EXTENSIONS
 #endif
 
+// Streaming buffer is split into segments, each guarded by fences so we never overwrite data the GPU is still reading
+#define IMGUI_IMPL_OPENGL_STREAM_SEGMENTS       3
+#define IMGUI_IMPL_OPENGL_STREAM_SEGMENT_FENCES 8
+#define IMGUI_IMPL_OPENGL_STREAM_MIN_SEGMENT    (1024 * 1024)
+
+// Texture name we never generate, used when we don't know what is bound
+#define IMGUI_IMPL_OPENGL_UNKNOWN_TEXTURE       ((GLuint)-1)
+
+// GL state last set by RenderDrawData in one GL context, so redundant state changes can be skipped.
+// VAO are not shared among GL contexts, so secondary viewports each keep their own in viewport->RendererUserData.
+struct ImGui_ImplOpenGL3_StateCache
+{
+    bool            Valid;                   // Context still holds the full render state we left in it (only when state backup is disabled)
+    unsigned int    Generation;              // Matches ImGui_ImplOpenGL3_Data::StateGeneration while Valid is trustworthy
+    GLuint          VertexArray;             // Persistent VAO for this context
+    GLuint          VertexBuffer;            // Buffer the vertex attributes currently point into
+    bool            ClipOriginLowerLeft;
+    GLuint          Texture;                 // Texture bound to unit 0, or IMGUI_IMPL_OPENGL_UNKNOWN_TEXTURE
+    GLint           Scissor[4];              // Current scissor box, width is -1 when unknown
+
+    ImGui_ImplOpenGL3_StateCache() { memset((void*)this, 0, sizeof(*this)); Reset(); }
+    void Reset() { Texture = IMGUI_IMPL_OPENGL_UNKNOWN_TEXTURE; Scissor[0] = Scissor[1] = 0; Scissor[2] = Scissor[3] = -1; }
+};
+
 // OpenGL Data
 struct ImGui_ImplOpenGL3_Data
 {
     GLuint          GlVersion;               // Extracted at runtime using GL_MAJOR_VERSION, GL_MINOR_VERSION queries (e.g. 320 for GL 3.2)
     char            GlslVersionString[32];   // Specified by user or detected based on compile time GL settings.
     GLuint          FontTexture;
+    GLuint          SdfFontTexture;          // Texture whose alpha channel is a signed distance field
+    ImFontAtlas*    SdfFontAtlas;
     GLuint          ShaderHandle;
     GLint           AttribLocationTex;       // Uniforms location
     GLint           AttribLocationProjMtx;
+    GLint           AttribLocationSdf;
     GLuint          AttribLocationVtxPos;    // Vertex attributes location
     GLuint          AttribLocationVtxUV;
     GLuint          AttribLocationVtxColor;
@@ -197,6 +241,23 @@ struct ImGui_ImplOpenGL3_Data
     GLsizeiptr      IndexBufferSize;
     bool            HasClipOrigin;
     bool            UseBufferSubData;
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_STREAMING
+    bool            UseStreamingBuffer;      // Copy all draw lists into one buffer per render, then draw with base vertex offsets
+    bool            HasBufferStorage;        // Keep the streaming buffer persistently mapped
+    GLuint          StreamHandle;
+    GLsizeiptr      StreamSegmentSize;
+    GLsizeiptr      StreamOffset;            // Write offset within the current segment
+    int             StreamSegment;
+    void*           StreamMappedData;        // Persistent mapping of the whole buffer, or NULL when mapping per upload
+    GLsync          StreamFences[IMGUI_IMPL_OPENGL_STREAM_SEGMENTS][IMGUI_IMPL_OPENGL_STREAM_SEGMENT_FENCES];
+    int             StreamFenceCount[IMGUI_IMPL_OPENGL_STREAM_SEGMENTS];
+#endif
+    bool            BackupState;             // Save and restore all GL state we touch in RenderDrawData (default: true)
+    unsigned int    StateGeneration;         // Bumped by ImGui_ImplOpenGL3_InvalidateStateCache()
+    bool            HasProjection;
+    float           Projection[4][4];        // Last projection uploaded to ShaderHandle (uniforms are program state, so shared among contexts)
+    GLint           Sdf;                     // Last value of the Sdf uniform, 0 after linking
+    ImGui_ImplOpenGL3_StateCache MainStateCache;
 
     ImGui_ImplOpenGL3_Data() { memset((void*)this, 0, sizeof(*this)); }
 };
@@ -243,7 +304,7 @@ bool    ImGui_ImplOpenGL3_Init(const char* glsl_version)
     IM_ASSERT(io.BackendRendererUserData == NULL && "Already initialized a renderer backend!");
 
     // Initialize our loader
-#if !defined(IMGUI_IMPL_OPENGL_ES2) && !defined(IMGUI_IMPL_OPENGL_ES3) && !defined(IMGUI_IMPL_OPENGL_LOADER_CUSTOM)
+#if !defined(IMGUI_IMPL_OPENGL_ES2) && !defined(IMGUI_IMPL_OPENGL_ES3) && !defined(IMGUI_IMPL_OPENGL_LOADER_CUSTOM) && !defined(IMGUI_IMPL_OPENGL_LOADER_GLAD)
     if (imgl3wInit() != 0)
     {
         fprintf(stderr, "Failed to initialize OpenGL loader!\n");
@@ -255,6 +316,7 @@ bool    ImGui_ImplOpenGL3_Init(const char* glsl_version)
     ImGui_ImplOpenGL3_Data* bd = IM_NEW(ImGui_ImplOpenGL3_Data)();
     io.BackendRendererUserData = (void*)bd;
     io.BackendRendererName = "imgui_impl_opengl3";
+    bd->BackupState = true;
 
     // Query for GL version (e.g. 320 for GL 3.2)
 #if !defined(IMGUI_IMPL_OPENGL_ES2)
@@ -312,6 +374,9 @@ bool    ImGui_ImplOpenGL3_Init(const char* glsl_version)
 
     // Detect extensions we support
     bd->HasClipOrigin = (bd->GlVersion >= 450);
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+    bd->HasBufferStorage = (bd->GlVersion >= 440);
+#endif
 #ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_EXTENSIONS
     GLint num_extensions = 0;
     glGetIntegerv(GL_NUM_EXTENSIONS, &num_extensions);
@@ -320,8 +385,20 @@ bool    ImGui_ImplOpenGL3_Init(const char* glsl_version)
         const char* extension = (const char*)glGetStringi(GL_EXTENSIONS, i);
         if (extension != NULL && strcmp(extension, "GL_ARB_clip_control") == 0)
             bd->HasClipOrigin = true;
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+        if (extension != NULL && strcmp(extension, "GL_ARB_buffer_storage") == 0)
+            bd->HasBufferStorage = true;
+#endif
     }
 #endif
+#if defined(IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE) && defined(IMGUI_IMPL_OPENGL_LOADER_GLAD)
+    // The bundled glad targets GL 4.1, so it only loads glBufferStorage() when the driver reports GL_ARB_buffer_storage
+    if (glBufferStorage == NULL)
+        bd->HasBufferStorage = false;
+#endif
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_STREAMING
+    bd->UseStreamingBuffer = (bd->GlVersion >= 320);
+#endif
 
     if (io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable)
         ImGui_ImplOpenGL3_InitPlatformInterface();
@@ -351,11 +428,65 @@ void    ImGui_ImplOpenGL3_NewFrame()
         ImGui_ImplOpenGL3_CreateDeviceObjects();
 }
 
-static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_width, int fb_height, GLuint vertex_array_object)
+void    ImGui_ImplOpenGL3_SetBackupState(bool backup)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    IM_ASSERT(bd != NULL && "Did you call ImGui_ImplOpenGL3_Init()?");
+    if (bd->BackupState != backup)
+    {
+        bd->BackupState = backup;
+        bd->StateGeneration++;
+    }
+}
+
+void    ImGui_ImplOpenGL3_InvalidateStateCache()
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    if (bd != NULL)
+        bd->StateGeneration++;
+}
+
+static ImGui_ImplOpenGL3_StateCache* ImGui_ImplOpenGL3_GetStateCache(ImDrawData* draw_data)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    ImGuiViewport* viewport = draw_data->OwnerViewport;
+    if (viewport != NULL && viewport->RendererUserData != NULL)
+        return (ImGui_ImplOpenGL3_StateCache*)viewport->RendererUserData;
+    return &bd->MainStateCache;
+}
+
+static void ImGui_ImplOpenGL3_SetupProjection(ImDrawData* draw_data, int fb_width, int fb_height, bool clip_origin_lower_left)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+
+    // Setup viewport, orthographic projection matrix
+    // Our visible imgui space lies from draw_data->DisplayPos (top left) to draw_data->DisplayPos+data_data->DisplaySize (bottom right). DisplayPos is (0,0) for single viewport apps.
+    glViewport(0, 0, (GLsizei)fb_width, (GLsizei)fb_height);
+    float L = draw_data->DisplayPos.x;
+    float R = draw_data->DisplayPos.x + draw_data->DisplaySize.x;
+    float T = draw_data->DisplayPos.y;
+    float B = draw_data->DisplayPos.y + draw_data->DisplaySize.y;
+    if (!clip_origin_lower_left) { float tmp = T; T = B; B = tmp; } // Swap top and bottom if origin is upper left
+    const float ortho_projection[4][4] =
+    {
+        { 2.0f/(R-L),   0.0f,         0.0f,   0.0f },
+        { 0.0f,         2.0f/(T-B),   0.0f,   0.0f },
+        { 0.0f,         0.0f,        -1.0f,   0.0f },
+        { (R+L)/(L-R),  (T+B)/(B-T),  0.0f,   1.0f },
+    };
+    if (bd->HasProjection && memcmp(bd->Projection, ortho_projection, sizeof(ortho_projection)) == 0)
+        return;
+    glUniformMatrix4fv(bd->AttribLocationProjMtx, 1, GL_FALSE, &ortho_projection[0][0]);
+    memcpy(bd->Projection, ortho_projection, sizeof(ortho_projection));
+    bd->HasProjection = true;
+}
+
+static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_width, int fb_height, ImGui_ImplOpenGL3_StateCache* cache)
 {
     ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
 
     // Setup render state: alpha-blending enabled, no face culling, no depth testing, scissor enabled, polygon fill
+    glActiveTexture(GL_TEXTURE0);
     glEnable(GL_BLEND);
     glBlendEquation(GL_FUNC_ADD);
     glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
@@ -372,8 +503,8 @@ static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_wid
 #endif
 
     // Support for GL 4.5 rarely used glClipControl(GL_UPPER_LEFT)
-#if defined(GL_CLIP_ORIGIN)
     bool clip_origin_lower_left = true;
+#if defined(GL_CLIP_ORIGIN)
     if (bd->HasClipOrigin)
     {
         GLenum current_clip_origin = 0; glGetIntegerv(GL_CLIP_ORIGIN, (GLint*)&current_clip_origin);
@@ -382,118 +513,441 @@ static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_wid
     }
 #endif
 
-    // Setup viewport, orthographic projection matrix
-    // Our visible imgui space lies from draw_data->DisplayPos (top left) to draw_data->DisplayPos+data_data->DisplaySize (bottom right). DisplayPos is (0,0) for single viewport apps.
-    glViewport(0, 0, (GLsizei)fb_width, (GLsizei)fb_height);
-    float L = draw_data->DisplayPos.x;
-    float R = draw_data->DisplayPos.x + draw_data->DisplaySize.x;
-    float T = draw_data->DisplayPos.y;
-    float B = draw_data->DisplayPos.y + draw_data->DisplaySize.y;
-#if defined(GL_CLIP_ORIGIN)
-    if (!clip_origin_lower_left) { float tmp = T; T = B; B = tmp; } // Swap top and bottom if origin is upper left
-#endif
-    const float ortho_projection[4][4] =
-    {
-        { 2.0f/(R-L),   0.0f,         0.0f,   0.0f },
-        { 0.0f,         2.0f/(T-B),   0.0f,   0.0f },
-        { 0.0f,         0.0f,        -1.0f,   0.0f },
-        { (R+L)/(L-R),  (T+B)/(B-T),  0.0f,   1.0f },
-    };
     glUseProgram(bd->ShaderHandle);
     glUniform1i(bd->AttribLocationTex, 0);
-    glUniformMatrix4fv(bd->AttribLocationProjMtx, 1, GL_FALSE, &ortho_projection[0][0]);
+    ImGui_ImplOpenGL3_SetupProjection(draw_data, fb_width, fb_height, clip_origin_lower_left);
 
 #ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_SAMPLER
     if (bd->GlVersion >= 330)
         glBindSampler(0, 0); // We use combined texture/sampler state. Applications using GL 3.3 may set that otherwise.
 #endif
 
-    (void)vertex_array_object;
 #ifdef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
-    glBindVertexArray(vertex_array_object);
+    glBindVertexArray(cache->VertexArray);
 #endif
 
     // Bind vertex/index buffers and setup attributes for ImDrawVert
-    glBindBuffer(GL_ARRAY_BUFFER, bd->VboHandle);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, bd->ElementsHandle);
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_STREAMING
+    if (bd->UseStreamingBuffer)
+    {
+        // Vertices and indices share the streaming buffer
+        glBindBuffer(GL_ARRAY_BUFFER, bd->StreamHandle);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, bd->StreamHandle);
+        cache->VertexBuffer = bd->StreamHandle;
+    }
+    else
+#endif
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, bd->VboHandle);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, bd->ElementsHandle);
+        cache->VertexBuffer = bd->VboHandle;
+    }
     glEnableVertexAttribArray(bd->AttribLocationVtxPos);
     glEnableVertexAttribArray(bd->AttribLocationVtxUV);
     glEnableVertexAttribArray(bd->AttribLocationVtxColor);
     glVertexAttribPointer(bd->AttribLocationVtxPos,   2, GL_FLOAT,         GL_FALSE, sizeof(ImDrawVert), (GLvoid*)IM_OFFSETOF(ImDrawVert, pos));
     glVertexAttribPointer(bd->AttribLocationVtxUV,    2, GL_FLOAT,         GL_FALSE, sizeof(ImDrawVert), (GLvoid*)IM_OFFSETOF(ImDrawVert, uv));
     glVertexAttribPointer(bd->AttribLocationVtxColor, 4, GL_UNSIGNED_BYTE, GL_TRUE,  sizeof(ImDrawVert), (GLvoid*)IM_OFFSETOF(ImDrawVert, col));
+
+    // Texture binding and scissor box are left for the draw loop to set
+    cache->ClipOriginLowerLeft = clip_origin_lower_left;
+    cache->Reset();
 }
 
-// OpenGL3 Render function.
-// Note that this implementation is little overcomplicated because we are saving/setting up/restoring every OpenGL state explicitly.
-// This is in order to be able to run within an OpenGL engine that doesn't do so.
-void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
+// Only touch the scissor box and texture binding when they change between consecutive draw commands
+static inline void ImGui_ImplOpenGL3_SetScissor(ImGui_ImplOpenGL3_StateCache* cache, GLint x, GLint y, GLint w, GLint h)
 {
-    // Avoid rendering when minimized, scale coordinates for retina displays (screen coordinates != framebuffer coordinates)
-    int fb_width = (int)(draw_data->DisplaySize.x * draw_data->FramebufferScale.x);
-    int fb_height = (int)(draw_data->DisplaySize.y * draw_data->FramebufferScale.y);
-    if (fb_width <= 0 || fb_height <= 0)
+    if (cache->Scissor[0] == x && cache->Scissor[1] == y && cache->Scissor[2] == w && cache->Scissor[3] == h)
         return;
+    cache->Scissor[0] = x; cache->Scissor[1] = y; cache->Scissor[2] = w; cache->Scissor[3] = h;
+    glScissor(x, y, (GLsizei)w, (GLsizei)h);
+}
 
+// The SDF font texture needs the shader to threshold its alpha, so switch modes along with the texture
+static inline void ImGui_ImplOpenGL3_BindTexture(ImGui_ImplOpenGL3_StateCache* cache, GLuint texture)
+{
+    if (cache->Texture == texture)
+        return;
+    cache->Texture = texture;
+    glBindTexture(GL_TEXTURE_2D, texture);
     ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    const GLint sdf = (texture != 0 && texture == bd->SdfFontTexture) ? 1 : 0;
+    if (bd->Sdf != sdf)
+    {
+        glUniform1i(bd->AttribLocationSdf, sdf);
+        bd->Sdf = sdf;
+    }
+}
 
-    // Backup GL state
-    GLenum last_active_texture; glGetIntegerv(GL_ACTIVE_TEXTURE, (GLint*)&last_active_texture);
-    glActiveTexture(GL_TEXTURE0);
-    GLuint last_program; glGetIntegerv(GL_CURRENT_PROGRAM, (GLint*)&last_program);
-    GLuint last_texture; glGetIntegerv(GL_TEXTURE_BINDING_2D, (GLint*)&last_texture);
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_STREAMING
+static void ImGui_ImplOpenGL3_DestroyStreamingBuffer()
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    for (int segment = 0; segment < IMGUI_IMPL_OPENGL_STREAM_SEGMENTS; segment++)
+    {
+        for (int i = 0; i < bd->StreamFenceCount[segment]; i++)
+            glDeleteSync(bd->StreamFences[segment][i]);
+        bd->StreamFenceCount[segment] = 0;
+    }
+    if (bd->StreamHandle)
+        glDeleteBuffers(1, &bd->StreamHandle); // Also releases any persistent mapping
+    bd->StreamHandle = 0;
+    bd->StreamMappedData = NULL;
+    bd->StreamSegmentSize = 0;
+    bd->StreamOffset = 0;
+    bd->StreamSegment = 0;
+}
+
+// Create the streaming buffer, large enough that a single segment holds at least 'min_segment_size' bytes.
+// Expects GL_ARRAY_BUFFER to be free for us to modify.
+static void ImGui_ImplOpenGL3_CreateStreamingBuffer(GLsizeiptr min_segment_size)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    GLsizeiptr segment_size = IMGUI_IMPL_OPENGL_STREAM_MIN_SEGMENT;
+    while (segment_size < min_segment_size)
+        segment_size *= 2;
+    bd->StreamSegmentSize = segment_size;
+    const GLsizeiptr buffer_size = segment_size * IMGUI_IMPL_OPENGL_STREAM_SEGMENTS;
+    glGenBuffers(1, &bd->StreamHandle);
+    glBindBuffer(GL_ARRAY_BUFFER, bd->StreamHandle);
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+    if (bd->HasBufferStorage)
+    {
+        // Coherent persistent mapping means writes are visible to the GPU without explicit flushes
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_ARRAY_BUFFER, buffer_size, NULL, flags);
+        bd->StreamMappedData = glMapBufferRange(GL_ARRAY_BUFFER, 0, buffer_size, flags);
+        if (bd->StreamMappedData != NULL)
+            return;
+
+        // Immutable storage can't be respecified, so start over with a mutable buffer if mapping failed
+        glDeleteBuffers(1, &bd->StreamHandle);
+        glGenBuffers(1, &bd->StreamHandle);
+        glBindBuffer(GL_ARRAY_BUFFER, bd->StreamHandle);
+        bd->HasBufferStorage = false;
+    }
+#endif
+    glBufferData(GL_ARRAY_BUFFER, buffer_size, NULL, GL_STREAM_DRAW);
+}
+
+// Reserve 'size' bytes in the streaming buffer, waiting on fences only when wrapping around onto a segment the
+// GPU may still be reading from. Returns the offset of the reserved space from the start of the buffer.
+static GLsizeiptr ImGui_ImplOpenGL3_ReserveStreamingBuffer(GLsizeiptr size)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    if (size > bd->StreamSegmentSize)
+    {
+        // Deleting the old buffer is safe even while in flight, since GL defers destruction until it's unused
+        ImGui_ImplOpenGL3_DestroyStreamingBuffer();
+        ImGui_ImplOpenGL3_CreateStreamingBuffer(size);
+    }
+    else if (bd->StreamOffset + size > bd->StreamSegmentSize)
+    {
+        bd->StreamSegment = (bd->StreamSegment + 1) % IMGUI_IMPL_OPENGL_STREAM_SEGMENTS;
+        bd->StreamOffset = 0;
+        const int segment = bd->StreamSegment;
+        for (int i = 0; i < bd->StreamFenceCount[segment]; i++)
+        {
+            // Segments are reused several renders later, so these fences have almost always signaled already
+            while (glClientWaitSync(bd->StreamFences[segment][i], GL_SYNC_FLUSH_COMMANDS_BIT, 1000000) == GL_TIMEOUT_EXPIRED) {}
+            glDeleteSync(bd->StreamFences[segment][i]);
+        }
+        bd->StreamFenceCount[segment] = 0;
+    }
+    const GLsizeiptr offset = bd->StreamSegment * bd->StreamSegmentSize + bd->StreamOffset;
+    bd->StreamOffset += size;
+    return offset;
+}
+
+// Fence the draws which read from the current segment. Each render may run on a different (shared) context,
+// so every render inserts its own fence into its own command stream.
+static void ImGui_ImplOpenGL3_FenceStreamingBuffer()
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    const int segment = bd->StreamSegment;
+    if (bd->StreamFenceCount[segment] == IMGUI_IMPL_OPENGL_STREAM_SEGMENT_FENCES)
+    {
+        // With more viewports than fence slots, the fences may come from different contexts, so none of them
+        // can be dropped unsignaled. Release those already signaled, and if there are none, wait on the oldest.
+        int count = 0;
+        for (int i = 0; i < bd->StreamFenceCount[segment]; i++)
+        {
+            GLsync fence = bd->StreamFences[segment][i];
+            if (glClientWaitSync(fence, 0, 0) == GL_TIMEOUT_EXPIRED)
+                bd->StreamFences[segment][count++] = fence;
+            else
+                glDeleteSync(fence);
+        }
+        if (count == IMGUI_IMPL_OPENGL_STREAM_SEGMENT_FENCES)
+        {
+            while (glClientWaitSync(bd->StreamFences[segment][0], GL_SYNC_FLUSH_COMMANDS_BIT, 1000000) == GL_TIMEOUT_EXPIRED) {}
+            glDeleteSync(bd->StreamFences[segment][0]);
+            memmove(&bd->StreamFences[segment][0], &bd->StreamFences[segment][1], sizeof(GLsync) * (IMGUI_IMPL_OPENGL_STREAM_SEGMENT_FENCES - 1));
+            count--;
+        }
+        bd->StreamFenceCount[segment] = count;
+    }
+    bd->StreamFences[segment][bd->StreamFenceCount[segment]++] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+// Copy every draw list into one contiguous region of the streaming buffer. Vertices are placed first, aligned
+// to a whole vertex so draws can address them purely through base vertex offsets, followed by indices.
+static void ImGui_ImplOpenGL3_UploadStreamingBuffer(ImDrawData* draw_data, GLint* out_base_vertex, GLsizeiptr* out_idx_offset)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    const GLsizeiptr vtx_size = (GLsizeiptr)draw_data->TotalVtxCount * (GLsizeiptr)sizeof(ImDrawVert);
+    const GLsizeiptr idx_size = (GLsizeiptr)draw_data->TotalIdxCount * (GLsizeiptr)sizeof(ImDrawIdx);
+    const GLsizeiptr idx_start = (vtx_size + (GLsizeiptr)sizeof(ImDrawIdx) - 1) / (GLsizeiptr)sizeof(ImDrawIdx) * (GLsizeiptr)sizeof(ImDrawIdx);
+    const GLsizeiptr size = idx_start + idx_size + (GLsizeiptr)sizeof(ImDrawVert); // Slack to align the start to a whole vertex
+
+    if (bd->StreamHandle == 0)
+        ImGui_ImplOpenGL3_CreateStreamingBuffer(size);
+    GLsizeiptr offset = ImGui_ImplOpenGL3_ReserveStreamingBuffer(size);
+    const GLsizeiptr vtx_offset = (offset + (GLsizeiptr)sizeof(ImDrawVert) - 1) / (GLsizeiptr)sizeof(ImDrawVert) * (GLsizeiptr)sizeof(ImDrawVert);
+    const GLsizeiptr copy_size = idx_start + idx_size;
+    glBindBuffer(GL_ARRAY_BUFFER, bd->StreamHandle);
+
+    char* dst = NULL;
+    if (bd->StreamMappedData != NULL)
+        dst = (char*)bd->StreamMappedData + vtx_offset;
+    else if (copy_size > 0)
+        dst = (char*)glMapBufferRange(GL_ARRAY_BUFFER, vtx_offset, copy_size, GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT);
+    if (dst != NULL)
+    {
+        char* vtx_dst = dst;
+        char* idx_dst = dst + idx_start;
+        for (int n = 0; n < draw_data->CmdListsCount; n++)
+        {
+            const ImDrawList* cmd_list = draw_data->CmdLists[n];
+            const size_t vtx_list_size = (size_t)cmd_list->VtxBuffer.Size * sizeof(ImDrawVert);
+            const size_t idx_list_size = (size_t)cmd_list->IdxBuffer.Size * sizeof(ImDrawIdx);
+            memcpy(vtx_dst, cmd_list->VtxBuffer.Data, vtx_list_size);
+            memcpy(idx_dst, cmd_list->IdxBuffer.Data, idx_list_size);
+            vtx_dst += vtx_list_size;
+            idx_dst += idx_list_size;
+        }
+        if (bd->StreamMappedData == NULL)
+            glUnmapBuffer(GL_ARRAY_BUFFER);
+    }
+    *out_base_vertex = (GLint)(vtx_offset / (GLsizeiptr)sizeof(ImDrawVert));
+    *out_idx_offset = vtx_offset + idx_start;
+}
+#endif
+
+// GL state touched by RenderDrawData, saved and restored around it unless state backup is disabled
+struct ImGui_ImplOpenGL3_BackupState
+{
+    GLenum      ActiveTexture;
+    GLuint      Program;
+    GLuint      Texture;
 #ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_SAMPLER
-    GLuint last_sampler; if (bd->GlVersion >= 330) { glGetIntegerv(GL_SAMPLER_BINDING, (GLint*)&last_sampler); } else { last_sampler = 0; }
+    GLuint      Sampler;
 #endif
-    GLuint last_array_buffer; glGetIntegerv(GL_ARRAY_BUFFER_BINDING, (GLint*)&last_array_buffer);
+    GLuint      ArrayBuffer;
 #ifndef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
-    // This is part of VAO on OpenGL 3.0+ and OpenGL ES 3.0+.
-    GLint last_element_array_buffer; glGetIntegerv(GL_ELEMENT_ARRAY_BUFFER_BINDING, &last_element_array_buffer);
-    ImGui_ImplOpenGL3_VtxAttribState last_vtx_attrib_state_pos; last_vtx_attrib_state_pos.GetState(bd->AttribLocationVtxPos);
-    ImGui_ImplOpenGL3_VtxAttribState last_vtx_attrib_state_uv; last_vtx_attrib_state_uv.GetState(bd->AttribLocationVtxUV);
-    ImGui_ImplOpenGL3_VtxAttribState last_vtx_attrib_state_color; last_vtx_attrib_state_color.GetState(bd->AttribLocationVtxColor);
+    GLint       ElementArrayBuffer;
+    ImGui_ImplOpenGL3_VtxAttribState VtxAttribStatePos, VtxAttribStateUV, VtxAttribStateColor;
 #endif
 #ifdef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
-    GLuint last_vertex_array_object; glGetIntegerv(GL_VERTEX_ARRAY_BINDING, (GLint*)&last_vertex_array_object);
+    GLuint      VertexArrayObject;
 #endif
 #ifdef IMGUI_IMPL_HAS_POLYGON_MODE
-    GLint last_polygon_mode[2]; glGetIntegerv(GL_POLYGON_MODE, last_polygon_mode);
-#endif
-    GLint last_viewport[4]; glGetIntegerv(GL_VIEWPORT, last_viewport);
-    GLint last_scissor_box[4]; glGetIntegerv(GL_SCISSOR_BOX, last_scissor_box);
-    GLenum last_blend_src_rgb; glGetIntegerv(GL_BLEND_SRC_RGB, (GLint*)&last_blend_src_rgb);
-    GLenum last_blend_dst_rgb; glGetIntegerv(GL_BLEND_DST_RGB, (GLint*)&last_blend_dst_rgb);
-    GLenum last_blend_src_alpha; glGetIntegerv(GL_BLEND_SRC_ALPHA, (GLint*)&last_blend_src_alpha);
-    GLenum last_blend_dst_alpha; glGetIntegerv(GL_BLEND_DST_ALPHA, (GLint*)&last_blend_dst_alpha);
-    GLenum last_blend_equation_rgb; glGetIntegerv(GL_BLEND_EQUATION_RGB, (GLint*)&last_blend_equation_rgb);
-    GLenum last_blend_equation_alpha; glGetIntegerv(GL_BLEND_EQUATION_ALPHA, (GLint*)&last_blend_equation_alpha);
-    GLboolean last_enable_blend = glIsEnabled(GL_BLEND);
-    GLboolean last_enable_cull_face = glIsEnabled(GL_CULL_FACE);
-    GLboolean last_enable_depth_test = glIsEnabled(GL_DEPTH_TEST);
-    GLboolean last_enable_stencil_test = glIsEnabled(GL_STENCIL_TEST);
-    GLboolean last_enable_scissor_test = glIsEnabled(GL_SCISSOR_TEST);
+    GLint       PolygonMode[2];
+#endif
+    GLint       Viewport[4];
+    GLint       ScissorBox[4];
+    GLenum      BlendSrcRgb, BlendDstRgb, BlendSrcAlpha, BlendDstAlpha;
+    GLenum      BlendEquationRgb, BlendEquationAlpha;
+    GLboolean   EnableBlend, EnableCullFace, EnableDepthTest, EnableStencilTest, EnableScissorTest;
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_PRIMITIVE_RESTART
+    GLboolean   EnablePrimitiveRestart;
+#endif
+
+    void Save(ImGui_ImplOpenGL3_Data* bd)
+    {
+        glGetIntegerv(GL_ACTIVE_TEXTURE, (GLint*)&ActiveTexture);
+        glActiveTexture(GL_TEXTURE0);
+        glGetIntegerv(GL_CURRENT_PROGRAM, (GLint*)&Program);
+        glGetIntegerv(GL_TEXTURE_BINDING_2D, (GLint*)&Texture);
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_SAMPLER
+        if (bd->GlVersion >= 330) { glGetIntegerv(GL_SAMPLER_BINDING, (GLint*)&Sampler); } else { Sampler = 0; }
+#endif
+        glGetIntegerv(GL_ARRAY_BUFFER_BINDING, (GLint*)&ArrayBuffer);
+#ifndef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
+        // This is part of VAO on OpenGL 3.0+ and OpenGL ES 3.0+.
+        glGetIntegerv(GL_ELEMENT_ARRAY_BUFFER_BINDING, &ElementArrayBuffer);
+        VtxAttribStatePos.GetState(bd->AttribLocationVtxPos);
+        VtxAttribStateUV.GetState(bd->AttribLocationVtxUV);
+        VtxAttribStateColor.GetState(bd->AttribLocationVtxColor);
+#endif
+#ifdef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
+        glGetIntegerv(GL_VERTEX_ARRAY_BINDING, (GLint*)&VertexArrayObject);
+#endif
+#ifdef IMGUI_IMPL_HAS_POLYGON_MODE
+        glGetIntegerv(GL_POLYGON_MODE, PolygonMode);
+#endif
+        glGetIntegerv(GL_VIEWPORT, Viewport);
+        glGetIntegerv(GL_SCISSOR_BOX, ScissorBox);
+        glGetIntegerv(GL_BLEND_SRC_RGB, (GLint*)&BlendSrcRgb);
+        glGetIntegerv(GL_BLEND_DST_RGB, (GLint*)&BlendDstRgb);
+        glGetIntegerv(GL_BLEND_SRC_ALPHA, (GLint*)&BlendSrcAlpha);
+        glGetIntegerv(GL_BLEND_DST_ALPHA, (GLint*)&BlendDstAlpha);
+        glGetIntegerv(GL_BLEND_EQUATION_RGB, (GLint*)&BlendEquationRgb);
+        glGetIntegerv(GL_BLEND_EQUATION_ALPHA, (GLint*)&BlendEquationAlpha);
+        EnableBlend = glIsEnabled(GL_BLEND);
+        EnableCullFace = glIsEnabled(GL_CULL_FACE);
+        EnableDepthTest = glIsEnabled(GL_DEPTH_TEST);
+        EnableStencilTest = glIsEnabled(GL_STENCIL_TEST);
+        EnableScissorTest = glIsEnabled(GL_SCISSOR_TEST);
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_PRIMITIVE_RESTART
+        EnablePrimitiveRestart = (bd->GlVersion >= 310) ? glIsEnabled(GL_PRIMITIVE_RESTART) : GL_FALSE;
+#endif
+        (void)bd; // Not all compilation paths use this
+    }
+    void Restore(ImGui_ImplOpenGL3_Data* bd)
+    {
+        glUseProgram(Program);
+        glBindTexture(GL_TEXTURE_2D, Texture);
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_SAMPLER
+        if (bd->GlVersion >= 330)
+            glBindSampler(0, Sampler);
+#endif
+        glActiveTexture(ActiveTexture);
+#ifdef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
+        glBindVertexArray(VertexArrayObject);
+#endif
+        glBindBuffer(GL_ARRAY_BUFFER, ArrayBuffer);
+#ifndef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ElementArrayBuffer);
+        VtxAttribStatePos.SetState(bd->AttribLocationVtxPos);
+        VtxAttribStateUV.SetState(bd->AttribLocationVtxUV);
+        VtxAttribStateColor.SetState(bd->AttribLocationVtxColor);
+#endif
+        glBlendEquationSeparate(BlendEquationRgb, BlendEquationAlpha);
+        glBlendFuncSeparate(BlendSrcRgb, BlendDstRgb, BlendSrcAlpha, BlendDstAlpha);
+        if (EnableBlend) glEnable(GL_BLEND); else glDisable(GL_BLEND);
+        if (EnableCullFace) glEnable(GL_CULL_FACE); else glDisable(GL_CULL_FACE);
+        if (EnableDepthTest) glEnable(GL_DEPTH_TEST); else glDisable(GL_DEPTH_TEST);
+        if (EnableStencilTest) glEnable(GL_STENCIL_TEST); else glDisable(GL_STENCIL_TEST);
+        if (EnableScissorTest) glEnable(GL_SCISSOR_TEST); else glDisable(GL_SCISSOR_TEST);
 #ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_PRIMITIVE_RESTART
-    GLboolean last_enable_primitive_restart = (bd->GlVersion >= 310) ? glIsEnabled(GL_PRIMITIVE_RESTART) : GL_FALSE;
+        if (bd->GlVersion >= 310) { if (EnablePrimitiveRestart) glEnable(GL_PRIMITIVE_RESTART); else glDisable(GL_PRIMITIVE_RESTART); }
+#endif
+
+#ifdef IMGUI_IMPL_HAS_POLYGON_MODE
+        glPolygonMode(GL_FRONT_AND_BACK, (GLenum)PolygonMode[0]);
+#endif
+        glViewport(Viewport[0], Viewport[1], (GLsizei)Viewport[2], (GLsizei)Viewport[3]);
+        glScissor(ScissorBox[0], ScissorBox[1], (GLsizei)ScissorBox[2], (GLsizei)ScissorBox[3]);
+        (void)bd; // Not all compilation paths use this
+    }
+};
+
+// OpenGL3 Render function.
+// Note that this implementation is little overcomplicated because we are saving/setting up/restoring every OpenGL state explicitly.
+// This is in order to be able to run within an OpenGL engine that doesn't do so.
+// Call ImGui_ImplOpenGL3_SetBackupState(false) when nothing else renders with GL in between, to skip the backup/restore and redundant state setup.
+void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
+{
+    // Avoid rendering when minimized, scale coordinates for retina displays (screen coordinates != framebuffer coordinates)
+    int fb_width = (int)(draw_data->DisplaySize.x * draw_data->FramebufferScale.x);
+    int fb_height = (int)(draw_data->DisplaySize.y * draw_data->FramebufferScale.y);
+    if (fb_width <= 0 || fb_height <= 0)
+        return;
+
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+
+    ImGui_ImplOpenGL3_StateCache* cache = ImGui_ImplOpenGL3_GetStateCache(draw_data);
+
+    // Backup GL state, unless the application promised not to touch GL behind our back, in which case we rely on what we set last time
+    ImGui_ImplOpenGL3_BackupState backup_state;
+    if (bd->BackupState)
+        backup_state.Save(bd);
+    const bool use_cache = !bd->BackupState && cache->Valid && cache->Generation == bd->StateGeneration;
+
+    // Upload all draw lists at once when streaming
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_STREAMING
+    GLint stream_base_vertex = 0;
+    GLsizeiptr stream_idx_offset = 0;
+    if (bd->UseStreamingBuffer)
+        ImGui_ImplOpenGL3_UploadStreamingBuffer(draw_data, &stream_base_vertex, &stream_idx_offset);
 #endif
 
     // Setup desired GL state
-    // Recreate the VAO every time (this is to easily allow multiple GL contexts to be rendered to. VAO are not shared among GL contexts)
+    // Each GL context keeps its own persistent VAO (VAO are not shared among GL contexts)
     // The renderer would actually work without any VAO bound, but then our VertexAttrib calls would overwrite the default one currently bound.
-    GLuint vertex_array_object = 0;
 #ifdef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
-    glGenVertexArrays(1, &vertex_array_object);
+    if (cache->VertexArray == 0)
+        glGenVertexArrays(1, &cache->VertexArray);
 #endif
-    ImGui_ImplOpenGL3_SetupRenderState(draw_data, fb_width, fb_height, vertex_array_object);
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_STREAMING
+    const GLuint vertex_buffer = bd->UseStreamingBuffer ? bd->StreamHandle : bd->VboHandle;
+#else
+    const GLuint vertex_buffer = bd->VboHandle;
+#endif
+    if (use_cache && cache->VertexBuffer == vertex_buffer)
+    {
+        // Everything but the viewport, projection and scissor test is still as we left it
+        glEnable(GL_SCISSOR_TEST);
+        glBindBuffer(GL_ARRAY_BUFFER, vertex_buffer);
+        ImGui_ImplOpenGL3_SetupProjection(draw_data, fb_width, fb_height, cache->ClipOriginLowerLeft);
+    }
+    else
+    {
+        ImGui_ImplOpenGL3_SetupRenderState(draw_data, fb_width, fb_height, cache);
+    }
+    bool state_modified = false;
 
     // Will project scissor/clipping rectangles into framebuffer space
     ImVec2 clip_off = draw_data->DisplayPos;         // (0,0) unless using multi-viewports
     ImVec2 clip_scale = draw_data->FramebufferScale; // (1,1) unless using retina display which are often (2,2)
 
     // Render command lists
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_STREAMING
+    GLint global_vtx_offset = stream_base_vertex;
+    GLsizeiptr global_idx_offset = stream_idx_offset;
+#endif
     for (int n = 0; n < draw_data->CmdListsCount; n++)
     {
         const ImDrawList* cmd_list = draw_data->CmdLists[n];
 
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_STREAMING
+        if (bd->UseStreamingBuffer)
+        {
+            for (int cmd_i = 0; cmd_i < cmd_list->CmdBuffer.Size; cmd_i++)
+            {
+                const ImDrawCmd* pcmd = &cmd_list->CmdBuffer[cmd_i];
+                if (pcmd->UserCallback != NULL)
+                {
+                    if (pcmd->UserCallback == ImDrawCallback_ResetRenderState)
+                        ImGui_ImplOpenGL3_SetupRenderState(draw_data, fb_width, fb_height, cache);
+                    else
+                    {
+                        pcmd->UserCallback(cmd_list, pcmd);
+                        cache->Reset();
+                        state_modified = true;
+                    }
+                    continue;
+                }
+
+                // Project scissor/clipping rectangles into framebuffer space
+                ImVec2 clip_min((pcmd->ClipRect.x - clip_off.x) * clip_scale.x, (pcmd->ClipRect.y - clip_off.y) * clip_scale.y);
+                ImVec2 clip_max((pcmd->ClipRect.z - clip_off.x) * clip_scale.x, (pcmd->ClipRect.w - clip_off.y) * clip_scale.y);
+                if (clip_max.x <= clip_min.x || clip_max.y <= clip_min.y)
+                    continue;
+                ImGui_ImplOpenGL3_SetScissor(cache, (int)clip_min.x, (int)((float)fb_height - clip_max.y), (int)(clip_max.x - clip_min.x), (int)(clip_max.y - clip_min.y));
+
+                // Bind texture, Draw directly from the shared streaming buffer
+                ImGui_ImplOpenGL3_BindTexture(cache, (GLuint)(intptr_t)pcmd->GetTexID());
+                glDrawElementsBaseVertex(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT,
+                    (void*)(intptr_t)(global_idx_offset + (GLsizeiptr)pcmd->IdxOffset * (GLsizeiptr)sizeof(ImDrawIdx)), global_vtx_offset + (GLint)pcmd->VtxOffset);
+            }
+            global_vtx_offset += cmd_list->VtxBuffer.Size;
+            global_idx_offset += (GLsizeiptr)cmd_list->IdxBuffer.Size * (GLsizeiptr)sizeof(ImDrawIdx);
+            continue;
+        }
+#endif
+
         // Upload vertex/index buffers
         // - On Intel windows drivers we got reports that regular glBufferData() led to accumulating leaks when using multi-viewports, so we started using orphaning + glBufferSubData(). (See https://github.com/ocornut/imgui/issues/4468)
         // - On NVIDIA drivers we got reports that using orphaning + glBufferSubData() led to glitches when using multi-viewports.
@@ -529,9 +983,13 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
                 // User callback, registered via ImDrawList::AddCallback()
                 // (ImDrawCallback_ResetRenderState is a special callback value used by the user to request the renderer to reset render state.)
                 if (pcmd->UserCallback == ImDrawCallback_ResetRenderState)
-                    ImGui_ImplOpenGL3_SetupRenderState(draw_data, fb_width, fb_height, vertex_array_object);
+                    ImGui_ImplOpenGL3_SetupRenderState(draw_data, fb_width, fb_height, cache);
                 else
+                {
                     pcmd->UserCallback(cmd_list, pcmd);
+                    cache->Reset();
+                    state_modified = true;
+                }
             }
             else
             {
@@ -542,10 +1000,10 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
                     continue;
 
                 // Apply scissor/clipping rectangle (Y is inverted in OpenGL)
-                glScissor((int)clip_min.x, (int)((float)fb_height - clip_max.y), (int)(clip_max.x - clip_min.x), (int)(clip_max.y - clip_min.y));
+                ImGui_ImplOpenGL3_SetScissor(cache, (int)clip_min.x, (int)((float)fb_height - clip_max.y), (int)(clip_max.x - clip_min.x), (int)(clip_max.y - clip_min.y));
 
                 // Bind texture, Draw
-                glBindTexture(GL_TEXTURE_2D, (GLuint)(intptr_t)pcmd->GetTexID());
+                ImGui_ImplOpenGL3_BindTexture(cache, (GLuint)(intptr_t)pcmd->GetTexID());
 #ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_VTX_OFFSET
                 if (bd->GlVersion >= 320)
                     glDrawElementsBaseVertex(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, (void*)(intptr_t)(pcmd->IdxOffset * sizeof(ImDrawIdx)), (GLint)pcmd->VtxOffset);
@@ -556,45 +1014,24 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
         }
     }
 
-    // Destroy the temporary VAO
-#ifdef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
-    glDeleteVertexArrays(1, &vertex_array_object);
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_STREAMING
+    if (bd->UseStreamingBuffer)
+        ImGui_ImplOpenGL3_FenceStreamingBuffer();
 #endif
 
-    // Restore modified GL state
-    glUseProgram(last_program);
-    glBindTexture(GL_TEXTURE_2D, last_texture);
-#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_SAMPLER
-    if (bd->GlVersion >= 330)
-        glBindSampler(0, last_sampler);
-#endif
-    glActiveTexture(last_active_texture);
-#ifdef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
-    glBindVertexArray(last_vertex_array_object);
-#endif
-    glBindBuffer(GL_ARRAY_BUFFER, last_array_buffer);
-#ifndef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, last_element_array_buffer);
-    last_vtx_attrib_state_pos.SetState(bd->AttribLocationVtxPos);
-    last_vtx_attrib_state_uv.SetState(bd->AttribLocationVtxUV);
-    last_vtx_attrib_state_color.SetState(bd->AttribLocationVtxColor);
-#endif
-    glBlendEquationSeparate(last_blend_equation_rgb, last_blend_equation_alpha);
-    glBlendFuncSeparate(last_blend_src_rgb, last_blend_dst_rgb, last_blend_src_alpha, last_blend_dst_alpha);
-    if (last_enable_blend) glEnable(GL_BLEND); else glDisable(GL_BLEND);
-    if (last_enable_cull_face) glEnable(GL_CULL_FACE); else glDisable(GL_CULL_FACE);
-    if (last_enable_depth_test) glEnable(GL_DEPTH_TEST); else glDisable(GL_DEPTH_TEST);
-    if (last_enable_stencil_test) glEnable(GL_STENCIL_TEST); else glDisable(GL_STENCIL_TEST);
-    if (last_enable_scissor_test) glEnable(GL_SCISSOR_TEST); else glDisable(GL_SCISSOR_TEST);
-#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_PRIMITIVE_RESTART
-    if (bd->GlVersion >= 310) { if (last_enable_primitive_restart) glEnable(GL_PRIMITIVE_RESTART); else glDisable(GL_PRIMITIVE_RESTART); }
-#endif
-
-#ifdef IMGUI_IMPL_HAS_POLYGON_MODE
-    glPolygonMode(GL_FRONT_AND_BACK, (GLenum)last_polygon_mode[0]);
-#endif
-    glViewport(last_viewport[0], last_viewport[1], (GLsizei)last_viewport[2], (GLsizei)last_viewport[3]);
-    glScissor(last_scissor_box[0], last_scissor_box[1], (GLsizei)last_scissor_box[2], (GLsizei)last_scissor_box[3]);
+    if (bd->BackupState)
+    {
+        // Restore modified GL state
+        backup_state.Restore(bd);
+        cache->Valid = false;
+    }
+    else
+    {
+        // Leave the scissor test disabled so glClear() covers the whole framebuffer next frame
+        glDisable(GL_SCISSOR_TEST);
+        cache->Valid = !state_modified;
+        cache->Generation = bd->StateGeneration;
+    }
     (void)bd; // Not all compilation paths use this
 }
 
@@ -639,9 +1076,74 @@ void ImGui_ImplOpenGL3_DestroyFontsTexture()
         glDeleteTextures(1, &bd->FontTexture);
         io.Fonts->SetTexID(0);
         bd->FontTexture = 0;
+        bd->StateGeneration++; // Deleting a bound texture unbinds it
+    }
+}
+
+bool ImGui_ImplOpenGL3_CreateSdfFontsTexture(ImFontAtlas* atlas)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    ImGui_ImplOpenGL3_DestroySdfFontsTexture();
+
+    // Same layout as the regular font texture, with distances in the alpha channel. Bilinear sampling is required to reconstruct edges.
+    unsigned char* pixels;
+    int width, height;
+    atlas->GetTexDataAsRGBA32(&pixels, &width, &height);
+    GLint last_texture;
+    glGetIntegerv(GL_TEXTURE_BINDING_2D, &last_texture);
+    glGenTextures(1, &bd->SdfFontTexture);
+    glBindTexture(GL_TEXTURE_2D, bd->SdfFontTexture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+#ifdef GL_UNPACK_ROW_LENGTH // Not on WebGL/ES
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+#endif
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+    atlas->SetTexID((ImTextureID)(intptr_t)bd->SdfFontTexture);
+    bd->SdfFontAtlas = atlas;
+    glBindTexture(GL_TEXTURE_2D, last_texture);
+    bd->StateGeneration++;
+    return true;
+}
+
+void ImGui_ImplOpenGL3_DestroySdfFontsTexture()
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    if (bd->SdfFontTexture)
+    {
+        glDeleteTextures(1, &bd->SdfFontTexture);
+        bd->SdfFontAtlas->SetTexID(0);
+        bd->SdfFontTexture = 0;
+        bd->SdfFontAtlas = NULL;
+        bd->StateGeneration++;
     }
 }
 
+bool ImGui_ImplOpenGL3_UpdateFontsTexture(ImFontAtlas* atlas, int x, int y, int w, int h)
+{
+    GLuint texture = (GLuint)(intptr_t)atlas->TexID;
+    if (texture == 0 || w <= 0 || h <= 0)
+        return false;
+    unsigned char* pixels;
+    int width, height;
+    atlas->GetTexDataAsRGBA32(&pixels, &width, &height);
+    IM_ASSERT(x >= 0 && y >= 0 && x + w <= width && y + h <= height);
+
+    GLint last_texture;
+    glGetIntegerv(GL_TEXTURE_BINDING_2D, &last_texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+#ifdef GL_UNPACK_ROW_LENGTH
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, width);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, w, h, GL_RGBA, GL_UNSIGNED_BYTE, pixels + ((size_t)y * width + x) * 4);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+#else
+    // Without row length (WebGL/ES2), upload whole rows
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, y, width, h, GL_RGBA, GL_UNSIGNED_BYTE, pixels + (size_t)y * width * 4);
+#endif
+    glBindTexture(GL_TEXTURE_2D, last_texture);
+    return true;
+}
+
 // If you get an error please report on github. You may try different GL context version or GLSL version. See GL<>GLSL version table at the top of this file.
 static bool CheckShader(GLuint handle, const char* desc)
 {
@@ -754,47 +1256,81 @@ bool    ImGui_ImplOpenGL3_CreateDeviceObjects()
         "    gl_Position = ProjMtx * vec4(Position.xy,0,1);\n"
         "}\n";
 
+    // With Sdf set, the texture alpha is a distance field with edges at 0.5, antialiased over one screen pixel
     const GLchar* fragment_shader_glsl_120 =
         "#ifdef GL_ES\n"
+        "    #extension GL_OES_standard_derivatives : enable\n"
         "    precision mediump float;\n"
         "#endif\n"
         "uniform sampler2D Texture;\n"
+        "uniform int Sdf;\n"
         "varying vec2 Frag_UV;\n"
         "varying vec4 Frag_Color;\n"
         "void main()\n"
         "{\n"
-        "    gl_FragColor = Frag_Color * texture2D(Texture, Frag_UV.st);\n"
+        "    vec4 tex = texture2D(Texture, Frag_UV.st);\n"
+        "    if (Sdf != 0)\n"
+        "    {\n"
+        "#if defined(GL_ES) && !defined(GL_OES_standard_derivatives)\n"
+        "        float width = 0.1;\n"
+        "#else\n"
+        "        float width = max(fwidth(tex.a) * 0.5, 0.0001);\n"
+        "#endif\n"
+        "        tex.a = smoothstep(0.5 - width, 0.5 + width, tex.a);\n"
+        "    }\n"
+        "    gl_FragColor = Frag_Color * tex;\n"
         "}\n";
 
     const GLchar* fragment_shader_glsl_130 =
         "uniform sampler2D Texture;\n"
+        "uniform int Sdf;\n"
         "in vec2 Frag_UV;\n"
         "in vec4 Frag_Color;\n"
         "out vec4 Out_Color;\n"
         "void main()\n"
         "{\n"
-        "    Out_Color = Frag_Color * texture(Texture, Frag_UV.st);\n"
+        "    vec4 tex = texture(Texture, Frag_UV.st);\n"
+        "    if (Sdf != 0)\n"
+        "    {\n"
+        "        float width = max(fwidth(tex.a) * 0.5, 0.0001);\n"
+        "        tex.a = smoothstep(0.5 - width, 0.5 + width, tex.a);\n"
+        "    }\n"
+        "    Out_Color = Frag_Color * tex;\n"
         "}\n";
 
     const GLchar* fragment_shader_glsl_300_es =
         "precision mediump float;\n"
         "uniform sampler2D Texture;\n"
+        "uniform int Sdf;\n"
         "in vec2 Frag_UV;\n"
         "in vec4 Frag_Color;\n"
         "layout (location = 0) out vec4 Out_Color;\n"
         "void main()\n"
         "{\n"
-        "    Out_Color = Frag_Color * texture(Texture, Frag_UV.st);\n"
+        "    vec4 tex = texture(Texture, Frag_UV.st);\n"
+        "    if (Sdf != 0)\n"
+        "    {\n"
+        "        float width = max(fwidth(tex.a) * 0.5, 0.0001);\n"
+        "        tex.a = smoothstep(0.5 - width, 0.5 + width, tex.a);\n"
+        "    }\n"
+        "    Out_Color = Frag_Color * tex;\n"
         "}\n";
 
     const GLchar* fragment_shader_glsl_410_core =
         "in vec2 Frag_UV;\n"
         "in vec4 Frag_Color;\n"
         "uniform sampler2D Texture;\n"
+        "uniform int Sdf;\n"
         "layout (location = 0) out vec4 Out_Color;\n"
         "void main()\n"
         "{\n"
-        "    Out_Color = Frag_Color * texture(Texture, Frag_UV.st);\n"
+        "    vec4 tex = texture(Texture, Frag_UV.st);\n"
+        "    if (Sdf != 0)\n"
+        "    {\n"
+        "        float width = max(fwidth(tex.a) * 0.5, 0.0001);\n"
+        "        tex.a = smoothstep(0.5 - width, 0.5 + width, tex.a);\n"
+        "    }\n"
+        "    Out_Color = Frag_Color * tex;\n"
         "}\n";
 
     // Select shaders matching our GLSL versions
@@ -848,6 +1384,8 @@ bool    ImGui_ImplOpenGL3_CreateDeviceObjects()
 
     bd->AttribLocationTex = glGetUniformLocation(bd->ShaderHandle, "Texture");
     bd->AttribLocationProjMtx = glGetUniformLocation(bd->ShaderHandle, "ProjMtx");
+    bd->AttribLocationSdf = glGetUniformLocation(bd->ShaderHandle, "Sdf");
+    bd->Sdf = 0;
     bd->AttribLocationVtxPos = (GLuint)glGetAttribLocation(bd->ShaderHandle, "Position");
     bd->AttribLocationVtxUV = (GLuint)glGetAttribLocation(bd->ShaderHandle, "UV");
     bd->AttribLocationVtxColor = (GLuint)glGetAttribLocation(bd->ShaderHandle, "Color");
@@ -873,8 +1411,18 @@ void    ImGui_ImplOpenGL3_DestroyDeviceObjects()
     ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
     if (bd->VboHandle)      { glDeleteBuffers(1, &bd->VboHandle); bd->VboHandle = 0; }
     if (bd->ElementsHandle) { glDeleteBuffers(1, &bd->ElementsHandle); bd->ElementsHandle = 0; }
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_STREAMING
+    ImGui_ImplOpenGL3_DestroyStreamingBuffer();
+#endif
     if (bd->ShaderHandle)   { glDeleteProgram(bd->ShaderHandle); bd->ShaderHandle = 0; }
+#ifdef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
+    if (bd->MainStateCache.VertexArray) { glDeleteVertexArrays(1, &bd->MainStateCache.VertexArray); bd->MainStateCache.VertexArray = 0; }
+#endif
+    bd->MainStateCache.Valid = false;
+    bd->HasProjection = false;
+    bd->StateGeneration++;
     ImGui_ImplOpenGL3_DestroyFontsTexture();
+    ImGui_ImplOpenGL3_DestroySdfFontsTexture();
 }
 
 //--------------------------------------------------------------------------------------------------------
@@ -883,6 +1431,19 @@ void    ImGui_ImplOpenGL3_DestroyDeviceObjects()
 // If you are new to dear imgui or creating a new binding for dear imgui, it is recommended that you completely ignore this section first..
 //--------------------------------------------------------------------------------------------------------
 
+static void ImGui_ImplOpenGL3_CreateWindow(ImGuiViewport* viewport)
+{
+    viewport->RendererUserData = IM_NEW(ImGui_ImplOpenGL3_StateCache)();
+}
+
+static void ImGui_ImplOpenGL3_DestroyWindow(ImGuiViewport* viewport)
+{
+    // The VAO is owned by the viewport's GL context, which is destroyed along with it
+    if (ImGui_ImplOpenGL3_StateCache* cache = (ImGui_ImplOpenGL3_StateCache*)viewport->RendererUserData)
+        IM_DELETE(cache);
+    viewport->RendererUserData = NULL;
+}
+
 static void ImGui_ImplOpenGL3_RenderWindow(ImGuiViewport* viewport, void*)
 {
     if (!(viewport->Flags & ImGuiViewportFlags_NoRendererClear))
@@ -897,6 +1458,8 @@ static void ImGui_ImplOpenGL3_RenderWindow(ImGuiViewport* viewport, void*)
 static void ImGui_ImplOpenGL3_InitPlatformInterface()
 {
     ImGuiPlatformIO& platform_io = ImGui::GetPlatformIO();
+    platform_io.Renderer_CreateWindow = ImGui_ImplOpenGL3_CreateWindow;
+    platform_io.Renderer_DestroyWindow = ImGui_ImplOpenGL3_DestroyWindow;
     platform_io.Renderer_RenderWindow = ImGui_ImplOpenGL3_RenderWindow;
 }
 
@@ -33,6 +33,21 @@ IMGUI_IMPL_API void     ImGui_ImplOpenGL3_DestroyFontsTexture();
 IMGUI_IMPL_API bool     ImGui_ImplOpenGL3_CreateDeviceObjects();
 IMGUI_IMPL_API void     ImGui_ImplOpenGL3_DestroyDeviceObjects();
 
+// (Optional) Upload a region of a font atlas texture after changing its pixels, e.g. to add glyphs without re-uploading the whole atlas.
+IMGUI_IMPL_API bool     ImGui_ImplOpenGL3_UpdateFontsTexture(ImFontAtlas* atlas, int x, int y, int w, int h);
+
+// (Optional) Signed distance field fonts
+// - Uploads a second font atlas whose alpha channel holds distance fields. Draw commands using its texture are thresholded in the shader, so its fonts stay sharp at any scale.
+// - Use ImFontAtlasFlags_NoBakedLines and ImFontAtlasFlags_NoMouseCursors on that atlas, as everything drawn with its texture goes through the SDF path.
+IMGUI_IMPL_API bool     ImGui_ImplOpenGL3_CreateSdfFontsTexture(ImFontAtlas* atlas);
+IMGUI_IMPL_API void     ImGui_ImplOpenGL3_DestroySdfFontsTexture();
+
+// (Optional) GL state tracking
+// - SetBackupState(false) skips saving/restoring GL state around RenderDrawData(). Only do this when nothing else renders with GL in between.
+// - Call InvalidateStateCache() after touching GL state (e.g. binding textures) while state backup is disabled.
+IMGUI_IMPL_API void     ImGui_ImplOpenGL3_SetBackupState(bool backup);
+IMGUI_IMPL_API void     ImGui_ImplOpenGL3_InvalidateStateCache();
+
 // Specific OpenGL ES versions
 //#define IMGUI_IMPL_OPENGL_ES2     // Auto-detected on Emscripten
 //#define IMGUI_IMPL_OPENGL_ES3     // Auto-detected on iOS/Android
@@ -0,0 +1,390 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2021 James Boer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include "ImfInternal.h"
+
+namespace ImFrame
+{
+	namespace
+	{
+		// Same as mINI, which trims names and stores them in lower case
+		std::string NormalizeName(std::string name)
+		{
+			mINI::INIStringUtil::trim(name);
+			mINI::INIStringUtil::toLower(name);
+			return name;
+		}
+
+		std::string FormatValue(std::monostate) { return std::string(); }
+		std::string FormatValue(float value) { return std::to_string(value); }
+		std::string FormatValue(double value) { return std::to_string(value); }
+		std::string FormatValue(int value) { return std::to_string(value); }
+		std::string FormatValue(bool value) { return value ? "1" : "0"; }
+
+		// Only values set in typed form since the last write need formatting, and those are all in changed
+		// sections.  Empty values are left out, as they read back the same as missing ones.
+		mINI::INIStructure CopySettings(std::deque<ConfigSection> & sections)
+		{
+			mINI::INIStructure ini;
+			for (auto & section : sections)
+			{
+				for (auto & [name, value] : section.values)
+				{
+					const std::string & text = GetConfigText(value);
+					if (!text.empty())
+						ini[section.name][name] = text;
+				}
+			}
+			return ini;
+		}
+
+		// Files are written under a temporary name, then renamed over the original.  Renaming replaces the file
+		// in one step, so it's never left partly written.
+		bool ReplaceFile(const std::filesystem::path & path, const std::function<bool(const std::filesystem::path &)> & write)
+		{
+			namespace fs = std::filesystem;
+			fs::path tempPath = path;
+			tempPath += ".tmp";
+			std::error_code error;
+			fs::remove(tempPath, error);
+			if (!write(tempPath))
+				return false;
+			fs::rename(tempPath, path, error);
+			return !error;
+		}
+
+		// mINI updates an existing file in place, keeping its comments and formatting, so the temporary file
+		// starts as a copy of the original
+		bool WriteTextFile(const std::filesystem::path & path, mINI::INIStructure & ini)
+		{
+			return ReplaceFile(path, [&] (const std::filesystem::path & tempPath)
+			{
+				std::error_code error;
+				if (std::filesystem::exists(path, error))
+					std::filesystem::copy_file(path, tempPath, error);
+				mINI::INIFile file(tempPath.string());
+				return !error && file.write(ini);
+			});
+		}
+
+		bool WriteBinaryFile(const std::filesystem::path & path, const std::string & data)
+		{
+			return ReplaceFile(path, [&] (const std::filesystem::path & tempPath)
+			{
+				std::ofstream file(tempPath, std::ios::out | std::ios::binary);
+				file.write(data.data(), data.size());
+				file.close();
+				return !file.fail();
+			});
+		}
+
+		// Binary files start with a header, followed by each section as its name size, value count, data size,
+		// name, and data.  Section data is each value as its name size, text size, name, and text.  Sizes are
+		// 32-bit, in the byte order of the machine that wrote them, as files aren't shared between machines.
+		const char BinaryConfigMagic[4] = { 'I', 'M', 'F', 'C' };
+		const uint32_t BinaryConfigVersion = 1;
+
+		void AppendUint32(std::string & data, uint32_t value)
+		{
+			data.append(reinterpret_cast<const char *>(&value), sizeof(value));
+		}
+
+		// Reads from encoded data, failing once anything would run past the end
+		struct BinaryReader
+		{
+			bool Read(uint32_t & value)
+			{
+				if (data.size() < sizeof(value))
+					return false;
+				std::memcpy(&value, data.data(), sizeof(value));
+				data.remove_prefix(sizeof(value));
+				return true;
+			}
+
+			bool Read(std::string_view & bytes, uint32_t size)
+			{
+				if (data.size() < size)
+					return false;
+				bytes = data.substr(0, size);
+				data.remove_prefix(size);
+				return true;
+			}
+
+			std::string_view data;
+		};
+	}
+
+	const std::string & GetConfigText(ConfigValue & value)
+	{
+		if (value.textStale)
+		{
+			value.text = std::visit([] (auto cached) { return FormatValue(cached); }, value.cached);
+			value.textStale = false;
+		}
+		return value.text;
+	}
+
+	ConfigSection & Config::GetSection(std::string name)
+	{
+		auto it = m_index.find(name);
+		if (it != m_index.end())
+			return *it->second;
+		auto & section = m_sections.emplace_back();
+		section.name = std::move(name);
+		m_index[section.name] = &section;
+		return section;
+	}
+
+	void Config::DecodeSection(ConfigSection & section)
+	{
+		if (section.decoded)
+			return;
+		section.decoded = true;
+		BinaryReader reader { section.encoded };
+		section.encoded = std::string_view();
+		section.index.reserve(section.encodedCount);
+		for (uint32_t i = 0; i < section.encodedCount; ++i)
+		{
+			uint32_t nameSize = 0;
+			uint32_t textSize = 0;
+			std::string_view name;
+			std::string_view text;
+			if (!reader.Read(nameSize) || !reader.Read(textSize) || !reader.Read(name, nameSize) || !reader.Read(text, textSize))
+				break;
+			auto & value = section.values.emplace_back(std::string(name), ConfigValue());
+			value.second.section = &section;
+			value.second.text = text;
+			section.index[value.first] = &value.second;
+		}
+	}
+
+	ConfigValue * Config::FindValue(const char * sectionName, const char * valueName)
+	{
+		auto section = m_index.find(NormalizeName(sectionName));
+		if (section == m_index.end())
+			return nullptr;
+		DecodeSection(*section->second);
+		auto value = section->second->index.find(NormalizeName(valueName));
+		return value != section->second->index.end() ? value->second : nullptr;
+	}
+
+	ConfigValue & Config::GetValue(const char * sectionName, const char * valueName)
+	{
+		auto & section = GetSection(NormalizeName(sectionName));
+		DecodeSection(section);
+		std::string name = NormalizeName(valueName);
+		auto it = section.index.find(name);
+		if (it != section.index.end())
+			return *it->second;
+		auto & value = section.values.emplace_back(std::move(name), ConfigValue());
+		value.second.section = &section;
+		section.index[value.first] = &value.second;
+		return value.second;
+	}
+
+	bool Config::IsDirty() const
+	{
+		return std::any_of(m_sections.begin(), m_sections.end(), [] (const ConfigSection & section) { return section.dirty; });
+	}
+
+	void Config::MarkDirty()
+	{
+		for (auto & section : m_sections)
+			section.dirty = true;
+	}
+
+	bool Config::Read(const std::filesystem::path & path)
+	{
+		m_sections.clear();
+		m_index.clear();
+		m_encoded.reset();
+		m_file = MappedFile();
+		MappedFile mapped(path);
+		if (mapped.GetSize() >= sizeof(BinaryConfigMagic) && std::memcmp(mapped.GetData(), BinaryConfigMagic, sizeof(BinaryConfigMagic)) == 0)
+			return ReadBinary(std::move(mapped));
+		mapped = MappedFile();
+		mINI::INIStructure ini;
+		mINI::INIFile file(path.string());
+		if (!file.read(ini))
+			return false;
+		for (const auto & [sectionName, values] : ini)
+		{
+			auto & section = GetSection(sectionName);
+			for (const auto & [valueName, text] : values)
+			{
+				auto & value = section.values.emplace_back(valueName, ConfigValue());
+				value.second.section = &section;
+				value.second.text = text;
+				section.index[value.first] = &value.second;
+			}
+		}
+		return true;
+	}
+
+	// Only the section list is read up front.  Values stay encoded in the mapped file until used.
+	bool Config::ReadBinary(MappedFile && file)
+	{
+		BinaryReader reader { std::string_view(file.GetData(), file.GetSize()) };
+		std::string_view magic;
+		uint32_t version = 0;
+		uint32_t sectionCount = 0;
+		reader.Read(magic, sizeof(BinaryConfigMagic));
+		if (!reader.Read(version) || version != BinaryConfigVersion || !reader.Read(sectionCount))
+			return false;
+		for (uint32_t i = 0; i < sectionCount; ++i)
+		{
+			uint32_t nameSize = 0;
+			uint32_t valueCount = 0;
+			uint32_t dataSize = 0;
+			std::string_view name;
+			std::string_view data;
+			if (!reader.Read(nameSize) || !reader.Read(valueCount) || !reader.Read(dataSize) || !reader.Read(name, nameSize) || !reader.Read(data, dataSize))
+			{
+				m_sections.clear();
+				m_index.clear();
+				return false;
+			}
+			auto & section = GetSection(std::string(name));
+			section.encoded = data;
+			section.encodedCount = valueCount;
+			section.decoded = false;
+		}
+		m_file = std::move(file);
+		return true;
+	}
+
+	// Sections never decoded are copied as they are.  They're pointed at the copy afterwards, which the
+	// worker thread only reads, so the mapped file can be closed and replaced by the write.
+	std::shared_ptr<const std::string> Config::EncodeBinary()
+	{
+		auto data = std::make_shared<std::string>();
+		data->append(BinaryConfigMagic, sizeof(BinaryConfigMagic));
+		AppendUint32(*data, BinaryConfigVersion);
+		AppendUint32(*data, static_cast<uint32_t>(m_sections.size()));
+		std::vector<std::pair<ConfigSection *, size_t>> copied;
+		for (auto & section : m_sections)
+		{
+			AppendUint32(*data, static_cast<uint32_t>(section.name.size()));
+			const size_t sizesOffset = data->size();
+			AppendUint32(*data, 0);
+			AppendUint32(*data, 0);
+			data->append(section.name);
+			const size_t dataOffset = data->size();
+			uint32_t valueCount = 0;
+			if (!section.decoded)
+			{
+				copied.emplace_back(&section, dataOffset);
+				data->append(section.encoded);
+				valueCount = section.encodedCount;
+			}
+			else
+			{
+				for (auto & [name, value] : section.values)
+				{
+					const std::string & text = GetConfigText(value);
+					if (text.empty())
+						continue;
+					AppendUint32(*data, static_cast<uint32_t>(name.size()));
+					AppendUint32(*data, static_cast<uint32_t>(text.size()));
+					data->append(name);
+					data->append(text);
+					++valueCount;
+				}
+			}
+			const uint32_t dataSize = static_cast<uint32_t>(data->size() - dataOffset);
+			std::memcpy(data->data() + sizesOffset, &valueCount, sizeof(valueCount));
+			std::memcpy(data->data() + sizesOffset + sizeof(valueCount), &dataSize, sizeof(dataSize));
+		}
+		for (auto & [section, offset] : copied)
+			section->encoded = std::string_view(data->data() + offset, section->encoded.size());
+		m_encoded = data;
+		m_file = MappedFile();
+		return data;
+	}
+
+	std::function<bool()> Config::CopyForWriting(const std::filesystem::path & path)
+	{
+		if (m_format == ConfigFormat::Binary)
+		{
+			auto data = EncodeBinary();
+			return [path, data] () { return WriteBinaryFile(path, *data); };
+		}
+		for (auto & section : m_sections)
+			DecodeSection(section);
+		auto ini = std::make_shared<mINI::INIStructure>(CopySettings(m_sections));
+		return [path, ini] () { return WriteTextFile(path, *ini); };
+	}
+
+	void Config::ClearDirty()
+	{
+		for (auto & section : m_sections)
+			section.dirty = false;
+	}
+
+	bool Config::Write(const std::filesystem::path & path)
+	{
+		WaitForWrite();
+		if (!IsDirty())
+			return true;
+		if (!CopyForWriting(path)())
+			return false;
+		ClearDirty();
+		return true;
+	}
+
+	void Config::WriteAsync(const std::filesystem::path & path)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_writeMutex);
+			if (m_writing)
+				return;
+
+			// Sections were marked saved when copied, so changes from a failed write need saving again
+			if (m_writeFailed.exchange(false))
+				MarkDirty();
+			if (!IsDirty())
+				return;
+			m_writing = true;
+		}
+		auto write = CopyForWriting(path);
+		ClearDirty();
+		GetThreadPool().EnqueuePriority([this, write] ()
+		{
+			if (!write())
+				m_writeFailed = true;
+			std::lock_guard<std::mutex> lock(m_writeMutex);
+			m_writing = false;
+			m_writeCondition.notify_all();
+		});
+	}
+
+	void Config::WaitForWrite()
+	{
+		std::unique_lock<std::mutex> lock(m_writeMutex);
+		m_writeCondition.wait(lock, [this] { return !m_writing; });
+		if (m_writeFailed.exchange(false))
+			MarkDirty();
+	}
+
+}
@@ -0,0 +1,160 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2021 James Boer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#pragma once
+
+
+namespace ImFrame
+{
+
+	struct ConfigSection;
+
+	// A single setting, stored as text.  Values read or written in typed form are cached that way, so they're
+	// only parsed once, and their text is only regenerated when needed, such as when saving.
+	struct ConfigValue
+	{
+		ConfigSection * section = nullptr;
+		std::string text;
+		std::variant<std::monostate, float, double, int, bool> cached;
+		bool textStale = false;
+	};
+
+	// Values are kept in a deque so they never move, letting handles keep pointers to them.  Sections read
+	// from a binary file keep their encoded values until first accessed.
+	struct ConfigSection
+	{
+		std::string name;
+		std::deque<std::pair<std::string, ConfigValue>> values;
+		std::unordered_map<std::string, ConfigValue *> index;
+		std::string_view encoded;
+		uint32_t encodedCount = 0;
+		bool decoded = true;
+		bool dirty = false;
+	};
+
+	// Text files are ini files written through mINI.  Binary files are a list of sections, each with its size,
+	// so sections can be skipped when reading and only decoded once used.
+	enum class ConfigFormat
+	{
+		Text,
+		Binary,
+	};
+
+	// Sections of settings read from and written to a file.  Section and value names aren't case sensitive.
+	// Reading detects either format, while writing uses the one set, so switching formats imports a file.
+	// Writing skips the file entirely if nothing changed since it was read or last written.
+	// Files are written to a temporary file first and renamed into place, so a crash mid-write leaves the
+	// previous file intact.  WriteAsync() copies the settings, then writes them on a worker thread, while
+	// Write() waits for any write still in progress before writing itself.
+	class Config
+	{
+	public:
+		Config() = default;
+		Config(const Config &) = delete;
+		Config & operator = (const Config &) = delete;
+
+		ConfigValue * FindValue(const char * sectionName, const char * valueName);
+		ConfigValue & GetValue(const char * sectionName, const char * valueName);
+		bool IsDirty() const;
+		void MarkDirty();
+		void SetFormat(ConfigFormat format) { m_format = format; }
+
+		bool Read(const std::filesystem::path & path);
+		bool Write(const std::filesystem::path & path);
+		void WriteAsync(const std::filesystem::path & path);
+		void WaitForWrite();
+
+	private:
+		ConfigSection & GetSection(std::string name);
+		void DecodeSection(ConfigSection & section);
+		void ClearDirty();
+		bool ReadBinary(MappedFile && file);
+		std::shared_ptr<const std::string> EncodeBinary();
+		std::function<bool()> CopyForWriting(const std::filesystem::path & path);
+
+		std::deque<ConfigSection> m_sections;
+		std::unordered_map<std::string, ConfigSection *> m_index;
+		ConfigFormat m_format = ConfigFormat::Text;
+		MappedFile m_file;
+		std::shared_ptr<const std::string> m_encoded;
+		std::mutex m_writeMutex;
+		std::condition_variable m_writeCondition;
+		bool m_writing = false;
+		std::atomic<bool> m_writeFailed = false;
+	};
+
+	// Text of a value, regenerated first if it was set in typed form
+	const std::string & GetConfigText(ConfigValue & value);
+
+	// Empty values are treated as missing, and return the default
+	template<typename T>
+	const T & GetConfigValue(ConfigValue & value, const T & defaultValue)
+	{
+		if constexpr (std::is_same_v<T, std::string>)
+		{
+			const std::string & text = GetConfigText(value);
+			return text.empty() ? defaultValue : text;
+		}
+		else
+		{
+			if (const T * cached = std::get_if<T>(&value.cached))
+				return *cached;
+			const std::string & text = GetConfigText(value);
+			if (text.empty())
+				return defaultValue;
+			if constexpr (std::is_same_v<T, float>)
+				value.cached = std::stof(text);
+			else if constexpr (std::is_same_v<T, double>)
+				value.cached = std::stod(text);
+			else if constexpr (std::is_same_v<T, int>)
+				value.cached = std::stoi(text);
+			else
+				value.cached = std::stoi(text) != 0;
+			return std::get<T>(value.cached);
+		}
+	}
+
+	// Setting a value to what it already holds doesn't mark its section as changed
+	template<typename T>
+	void SetConfigValue(ConfigValue & value, const T & newValue)
+	{
+		if constexpr (std::is_same_v<T, std::string>)
+		{
+			if (!value.textStale && value.text == newValue)
+				return;
+			value.text = newValue;
+			value.cached = std::monostate();
+			value.textStale = false;
+		}
+		else
+		{
+			if (const T * cached = std::get_if<T>(&value.cached); cached && *cached == newValue)
+				return;
+			value.cached = newValue;
+			value.textStale = true;
+		}
+		value.section->dirty = true;
+	}
+
+}
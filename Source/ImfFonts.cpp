@@ -0,0 +1,884 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2021 James Boer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include "ImfInternal.h"
+
+#include <imgui_internal.h>
+
+#ifdef _MSC_VER
+#pragma warning (push)
+#pragma warning (disable: 4244 4456 4457 4702)
+#endif
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wtype-limits"
+#pragma GCC diagnostic ignored "-Wimplicit-fallthrough"
+#endif
+#define STBTT_STATIC
+#define STB_TRUETYPE_IMPLEMENTATION
+#include <imstb_truetype.h>
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+#ifdef _MSC_VER
+#pragma warning (pop)
+#endif
+
+#include "Fonts/CarlitoRegular.h"
+#include "Fonts/OpenSansRegular.h"
+#include "Fonts/OpenSansSemiBold.h"
+#include "Fonts/RobotoMedium.h"
+#include "Fonts/RobotoRegular.h"
+
+namespace ImFrame
+{
+
+	namespace
+	{
+
+		// Bump the version whenever the embedded fonts or the way atlases are built change, since cached atlases
+		// are only keyed on which fonts they hold
+		const uint32_t FontCacheMagic = 0x41464D49;	// "IMFA"
+		const uint32_t FontCacheVersion = 2;
+		const size_t MaxCachedFontAtlases = 16;
+
+		// Distance fields are rasterized at one size and scaled by the renderer.  The spread is how many pixels
+		// either side of an edge the field covers, which limits how far glyphs can be scaled down cleanly.
+		const int MaxFontAtlasHeight = 8192;
+		const float SdfFontSize = 32.0f;
+		const int SdfFontSpread = 4;
+		const ImWchar SdfFontRanges[] = { 0x0020, 0x0020, 0 };
+
+		// FNV-1a, which is plenty for telling font configurations apart
+		class Hasher
+		{
+		public:
+			void Add(const void * data, size_t size)
+			{
+				auto bytes = static_cast<const uint8_t *>(data);
+				for (size_t i = 0; i < size; ++i)
+					m_hash = (m_hash ^ bytes[i]) * 0x100000001B3ull;
+			}
+
+			template<typename T>
+			void Add(const T & value)
+			{
+				static_assert(std::is_trivially_copyable_v<T>);
+				Add(&value, sizeof(T));
+			}
+
+			uint64_t Get() const { return m_hash; }
+
+		private:
+			uint64_t m_hash = 0xCBF29CE484222325ull;
+		};
+
+		class CacheWriter
+		{
+		public:
+			void Write(const void * data, size_t size)
+			{
+				auto bytes = static_cast<const uint8_t *>(data);
+				m_buffer.insert(m_buffer.end(), bytes, bytes + size);
+			}
+
+			template<typename T>
+			void Write(const T & value)
+			{
+				static_assert(std::is_trivially_copyable_v<T>);
+				Write(&value, sizeof(T));
+			}
+
+			const std::vector<uint8_t> & GetBuffer() const { return m_buffer; }
+
+		private:
+			std::vector<uint8_t> m_buffer;
+		};
+
+		// Reads fail once past the end of the buffer, and stay failed
+		class CacheReader
+		{
+		public:
+			explicit CacheReader(const std::vector<uint8_t> & buffer) : m_buffer(buffer) {}
+
+			bool Read(void * data, size_t size)
+			{
+				if (!m_valid || m_buffer.size() - m_position < size)
+					return m_valid = false;
+				std::memcpy(data, m_buffer.data() + m_position, size);
+				m_position += size;
+				return true;
+			}
+
+			template<typename T>
+			bool Read(T & value)
+			{
+				static_assert(std::is_trivially_copyable_v<T>);
+				return Read(&value, sizeof(T));
+			}
+
+			bool IsComplete() const { return m_valid && m_position == m_buffer.size(); }
+
+		private:
+			const std::vector<uint8_t> & m_buffer;
+			size_t m_position = 0;
+			bool m_valid = true;
+		};
+
+		// Covers everything that affects the built atlas: the cache version, ImGui's, which fonts it holds at what
+		// sizes, and their glyph ranges.  Font sizes are in rasterized pixels, so any DPI scaling applied to them is
+		// part of the key too.  Nothing needs decompressing to work this out.
+		uint64_t GetAtlasKey(const std::vector<std::pair<FontType, float>> & fonts, const ImWchar * ranges, bool sdf)
+		{
+			Hasher hasher;
+			hasher.Add(FontCacheVersion);
+			hasher.Add(IMGUI_VERSION_NUM);
+			hasher.Add(sizeof(ImFontGlyph));
+			hasher.Add(sdf);
+			hasher.Add(SdfFontSize);
+			hasher.Add(SdfFontSpread);
+			hasher.Add(fonts.size());
+			for (const auto & font : fonts)
+			{
+				hasher.Add(font.first);
+				hasher.Add(font.second);
+			}
+			for (; ranges && ranges[0]; ranges += 2)
+			{
+				hasher.Add(ranges[0]);
+				hasher.Add(ranges[1]);
+			}
+			return hasher.Get();
+		}
+
+		std::filesystem::path GetCachePath(const std::filesystem::path & cacheFolder, uint64_t key)
+		{
+			char filename[32];
+			snprintf(filename, std::size(filename), "%016llx.bin", static_cast<unsigned long long>(key));
+			return cacheFolder / filename;
+		}
+
+		// Stores the atlas pixels, custom rect positions and glyph metrics.  Everything else is either part of
+		// the key or rebuilt from these on load.
+		void SaveAtlas(const ImFontAtlas * atlas, uint64_t key, const std::filesystem::path & path)
+		{
+			if (!atlas->TexPixelsAlpha8 || atlas->TexPixelsUseColors)
+				return;
+			CacheWriter writer;
+			writer.Write(FontCacheMagic);
+			writer.Write(FontCacheVersion);
+			writer.Write(key);
+			writer.Write(atlas->TexWidth);
+			writer.Write(atlas->TexHeight);
+			writer.Write(atlas->TexUvScale);
+			writer.Write(atlas->TexUvWhitePixel);
+			writer.Write(atlas->TexUvLines);
+			writer.Write(atlas->PackIdMouseCursors);
+			writer.Write(atlas->PackIdLines);
+			writer.Write(atlas->CustomRects.Size);
+			for (const auto & rect : atlas->CustomRects)
+			{
+				writer.Write(rect.Width);
+				writer.Write(rect.Height);
+				writer.Write(rect.X);
+				writer.Write(rect.Y);
+				writer.Write(rect.GlyphID);
+				writer.Write(rect.GlyphAdvanceX);
+				writer.Write(rect.GlyphOffset);
+				writer.Write(rect.Font ? atlas->Fonts.index_from_ptr(std::find(atlas->Fonts.begin(), atlas->Fonts.end(), rect.Font)) : -1);
+			}
+			writer.Write(atlas->Fonts.Size);
+			for (const ImFont * font : atlas->Fonts)
+			{
+				writer.Write(font->FontSize);
+				writer.Write(font->Ascent);
+				writer.Write(font->Descent);
+				writer.Write(font->MetricsTotalSurface);
+				writer.Write(font->Glyphs.Size);
+				writer.Write(font->Glyphs.Data, font->Glyphs.size_in_bytes());
+			}
+			writer.Write(atlas->TexPixelsAlpha8, static_cast<size_t>(atlas->TexWidth) * atlas->TexHeight);
+
+			std::error_code error;
+			std::filesystem::create_directories(path.parent_path(), error);
+			std::ofstream file(path, std::ios::binary | std::ios::trunc);
+			file.write(reinterpret_cast<const char *>(writer.GetBuffer().data()), static_cast<std::streamsize>(writer.GetBuffer().size()));
+		}
+
+		// Deletes the least recently used atlases beyond the limit.  Loading an atlas marks it used by updating
+		// its modification time.
+		void PruneCache(const std::filesystem::path & cacheFolder)
+		{
+			std::error_code error;
+			std::vector<std::pair<std::filesystem::file_time_type, std::filesystem::path>> files;
+			for (std::filesystem::directory_iterator it(cacheFolder, error), end; !error && it != end; it.increment(error))
+			{
+				if (it->path().extension() != ".bin" || !it->is_regular_file(error))
+					continue;
+				const auto time = it->last_write_time(error);
+				if (!error)
+					files.emplace_back(time, it->path());
+			}
+			if (files.size() <= MaxCachedFontAtlases)
+				return;
+			std::sort(files.begin(), files.end(), [] (const auto & a, const auto & b) { return a.first > b.first; });
+			for (size_t i = MaxCachedFontAtlases; i < files.size(); ++i)
+				std::filesystem::remove(files[i].second, error);
+		}
+
+		// Everything is read and validated before the atlas is touched, so a stale or truncated file just
+		// falls back to a regular build.
+		bool LoadAtlas(ImFontAtlas * atlas, uint64_t key, const std::filesystem::path & path)
+		{
+			std::ifstream file(path, std::ios::binary);
+			if (!file)
+				return false;
+			std::vector<uint8_t> buffer((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+			CacheReader reader(buffer);
+
+			uint32_t magic = 0;
+			uint32_t version = 0;
+			uint64_t fileKey = 0;
+			if (!reader.Read(magic) || !reader.Read(version) || !reader.Read(fileKey) ||
+				magic != FontCacheMagic || version != FontCacheVersion || fileKey != key)
+				return false;
+
+			int width = 0;
+			int height = 0;
+			ImVec2 uvScale;
+			ImVec2 uvWhitePixel;
+			ImVec4 uvLines[IM_ARRAYSIZE(atlas->TexUvLines)];
+			int packIdMouseCursors = 0;
+			int packIdLines = 0;
+			int rectCount = 0;
+			reader.Read(width);
+			reader.Read(height);
+			reader.Read(uvScale);
+			reader.Read(uvWhitePixel);
+			reader.Read(uvLines);
+			reader.Read(packIdMouseCursors);
+			reader.Read(packIdLines);
+			if (!reader.Read(rectCount) || rectCount < 0 || static_cast<size_t>(rectCount) > buffer.size() / sizeof(ImFontAtlasCustomRect))
+				return false;
+			std::vector<std::pair<ImFontAtlasCustomRect, int>> rects(rectCount);
+			for (auto & rect : rects)
+			{
+				reader.Read(rect.first.Width);
+				reader.Read(rect.first.Height);
+				reader.Read(rect.first.X);
+				reader.Read(rect.first.Y);
+				reader.Read(rect.first.GlyphID);
+				reader.Read(rect.first.GlyphAdvanceX);
+				reader.Read(rect.first.GlyphOffset);
+				reader.Read(rect.second);
+			}
+
+			struct FontMetrics
+			{
+				float fontSize;
+				float ascent;
+				float descent;
+				int metricsTotalSurface;
+				std::vector<ImFontGlyph> glyphs;
+			};
+			int fontCount = 0;
+			if (!reader.Read(fontCount) || fontCount != atlas->Fonts.Size)
+				return false;
+			std::vector<FontMetrics> fonts(fontCount);
+			for (auto & font : fonts)
+			{
+				int glyphCount = 0;
+				reader.Read(font.fontSize);
+				reader.Read(font.ascent);
+				reader.Read(font.descent);
+				reader.Read(font.metricsTotalSurface);
+				if (!reader.Read(glyphCount) || glyphCount < 0 || static_cast<size_t>(glyphCount) > buffer.size() / sizeof(ImFontGlyph))
+					return false;
+				font.glyphs.resize(glyphCount);
+				reader.Read(font.glyphs.data(), font.glyphs.size() * sizeof(ImFontGlyph));
+			}
+			if (width <= 0 || height <= 0 || static_cast<size_t>(width) * height > buffer.size())
+				return false;
+			std::vector<uint8_t> pixels(static_cast<size_t>(width) * height);
+			reader.Read(pixels.data(), pixels.size());
+			if (!reader.IsComplete() || packIdMouseCursors >= rectCount || packIdLines >= rectCount)
+				return false;
+			for (const auto & rect : rects)
+			{
+				if (rect.second < -1 || rect.second >= fontCount)
+					return false;
+			}
+
+			// Apply the cached build
+			atlas->ClearTexData();
+			atlas->TexPixelsAlpha8 = static_cast<unsigned char *>(IM_ALLOC(pixels.size()));
+			std::memcpy(atlas->TexPixelsAlpha8, pixels.data(), pixels.size());
+			atlas->TexPixelsUseColors = false;
+			atlas->TexWidth = width;
+			atlas->TexHeight = height;
+			atlas->TexUvScale = uvScale;
+			atlas->TexUvWhitePixel = uvWhitePixel;
+			std::copy(std::begin(uvLines), std::end(uvLines), atlas->TexUvLines);
+			atlas->CustomRects.resize(rectCount);
+			for (int i = 0; i < rectCount; ++i)
+			{
+				atlas->CustomRects[i] = rects[i].first;
+				atlas->CustomRects[i].Font = rects[i].second >= 0 ? atlas->Fonts[rects[i].second] : nullptr;
+			}
+			atlas->PackIdMouseCursors = packIdMouseCursors;
+			atlas->PackIdLines = packIdLines;
+			for (int i = 0; i < fontCount; ++i)
+			{
+				ImFont * font = atlas->Fonts[i];
+				font->ClearOutputData();
+				font->ConfigData = nullptr;
+				font->ConfigDataCount = 0;
+				for (auto & config : atlas->ConfigData)
+				{
+					if (config.DstFont != font)
+						continue;
+					if (!font->ConfigData)
+						font->ConfigData = &config;
+					++font->ConfigDataCount;
+				}
+				font->ContainerAtlas = atlas;
+				font->FontSize = fonts[i].fontSize;
+				font->Ascent = fonts[i].ascent;
+				font->Descent = fonts[i].descent;
+				font->MetricsTotalSurface = fonts[i].metricsTotalSurface;
+				font->Glyphs.resize(static_cast<int>(fonts[i].glyphs.size()));
+				std::copy(fonts[i].glyphs.begin(), fonts[i].glyphs.end(), font->Glyphs.begin());
+				font->BuildLookupTable();
+			}
+			atlas->TexReady = true;
+
+			std::error_code error;
+			std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), error);
+			return true;
+		}
+
+		// Fonts are added with a placeholder for their data, so restoring a cached atlas never needs them
+		// decompressed.  A build, or baking more glyphs later, loads the data first.
+		const uint32_t PendingFontMagic = 0x46504D49;	// "IMPF"
+		const int DefaultFontType = -1;
+
+		struct PendingFontData
+		{
+			uint32_t magic;
+			int type;
+		};
+
+		const PendingFontData * GetPendingFontData(const ImFontConfig & config)
+		{
+			auto pending = static_cast<const PendingFontData *>(config.FontData);
+			if (config.FontDataSize != sizeof(PendingFontData) || pending->magic != PendingFontMagic)
+				return nullptr;
+			return pending;
+		}
+
+		ImFont * AddPendingFont(ImFontAtlas * atlas, int type, ImFontConfig & config)
+		{
+			auto pending = static_cast<PendingFontData *>(IM_ALLOC(sizeof(PendingFontData)));
+			pending->magic = PendingFontMagic;
+			pending->type = type;
+			config.FontData = pending;
+			config.FontDataSize = sizeof(PendingFontData);
+			config.FontDataOwnedByAtlas = true;
+			return atlas->AddFont(&config);
+		}
+
+		// Only the decompressed data is wanted, so the size doesn't matter
+		void AddCompressedFont(ImFontAtlas * atlas, FontType type)
+		{
+			switch (type)
+			{
+				case FontType::CarlitoRegular:
+					atlas->AddFontFromMemoryCompressedTTF((void *)(&CarlitoRegular_compressed_data[0]), CarlitoRegular_compressed_size, SdfFontSize);
+					break;
+				case FontType::OpenSansRegular:
+					atlas->AddFontFromMemoryCompressedTTF((void *)(&OpenSansRegular_compressed_data[0]), OpenSansRegular_compressed_size, SdfFontSize);
+					break;
+				case FontType::OpenSansSemiBold:
+					atlas->AddFontFromMemoryCompressedTTF((void *)(&OpenSansSemiBold_compressed_data[0]), OpenSansSemiBold_compressed_size, SdfFontSize);
+					break;
+				case FontType::RobotoMedium:
+					atlas->AddFontFromMemoryCompressedTTF((void *)(&RobotoMedium_compressed_data[0]), RobotoMedium_compressed_size, SdfFontSize);
+					break;
+				case FontType::RobotoRegular:
+				default:
+					atlas->AddFontFromMemoryCompressedTTF((void *)(&RobotoRegular_compressed_data[0]), RobotoRegular_compressed_size, SdfFontSize);
+					break;
+			}
+		}
+
+		// Decompresses a pending font's data into its config, taking it from a scratch atlas
+		void LoadFontData(ImFontConfig & config)
+		{
+			const PendingFontData * pending = GetPendingFontData(config);
+			if (!pending)
+				return;
+			ImFontAtlas scratch;
+			if (pending->type == DefaultFontType)
+				scratch.AddFontDefault();
+			else
+				AddCompressedFont(&scratch, static_cast<FontType>(pending->type));
+			ImFontConfig & source = scratch.ConfigData.front();
+			IM_FREE(config.FontData);
+			config.FontData = source.FontData;
+			config.FontDataSize = source.FontDataSize;
+			config.FontDataOwnedByAtlas = true;
+			source.FontData = nullptr;
+		}
+
+		bool InitFontInfo(stbtt_fontinfo * info, const ImFontConfig & config)
+		{
+			if (GetPendingFontData(config))
+				return false;
+			auto data = static_cast<const unsigned char *>(config.FontData);
+			return stbtt_InitFont(info, data, stbtt_GetFontOffsetForIndex(data, config.FontNo)) != 0;
+		}
+
+		// Fills the custom glyph rects of a built atlas with distance fields.  Only SDF fonts add custom glyphs
+		// to ImFrame's atlases.
+		void RenderSdfGlyphs(ImFontAtlas * atlas)
+		{
+			const ImFont * currentFont = nullptr;
+			stbtt_fontinfo info = {};
+			float scale = 0.0f;
+			for (const auto & rect : atlas->CustomRects)
+			{
+				if (!rect.Font || !rect.GlyphID || !rect.Font->ConfigData)
+					continue;
+				if (rect.Font != currentFont)
+				{
+					currentFont = rect.Font;
+					if (!InitFontInfo(&info, *currentFont->ConfigData))
+						return;
+					scale = stbtt_ScaleForPixelHeight(&info, currentFont->ConfigData->SizePixels);
+				}
+				int width = 0;
+				int height = 0;
+				int xOffset = 0;
+				int yOffset = 0;
+				const int glyph = stbtt_FindGlyphIndex(&info, rect.GlyphID);
+				unsigned char * field = stbtt_GetGlyphSDF(&info, scale, glyph, SdfFontSpread, 128, 128.0f / SdfFontSpread, &width, &height, &xOffset, &yOffset);
+				if (!field)
+					continue;
+				width = std::min<int>(width, rect.Width);
+				height = std::min<int>(height, rect.Height);
+				for (int y = 0; y < height; ++y)
+					std::memcpy(atlas->TexPixelsAlpha8 + (rect.Y + y) * atlas->TexWidth + rect.X, field + y * width, width);
+				stbtt_FreeSDF(field, nullptr);
+			}
+		}
+
+	}
+
+	ImFont * AddDefaultFont(ImFontAtlas * atlas)
+	{
+		// Matches ImFontAtlas::AddFontDefault()
+		ImFontConfig config;
+		config.OversampleH = config.OversampleV = 1;
+		config.PixelSnapH = true;
+		config.SizePixels = 13.0f;
+		ImFormatString(config.Name, IM_ARRAYSIZE(config.Name), "ProggyClean.ttf, %dpx", static_cast<int>(config.SizePixels));
+		config.EllipsisChar = static_cast<ImWchar>(0x0085);
+		config.GlyphOffset.y = 1.0f;
+		config.GlyphRanges = atlas->GetGlyphRangesDefault();
+		return AddPendingFont(atlas, DefaultFontType, config);
+	}
+
+	ImFont * AddEmbeddedFont(ImFontAtlas * atlas, FontType type, float pixelSize, const ImWchar * ranges)
+	{
+		ImFontConfig config;
+		config.SizePixels = pixelSize;
+		config.GlyphRanges = ranges ? ranges : atlas->GetGlyphRangesDefault();
+		return AddPendingFont(atlas, static_cast<int>(type), config);
+	}
+
+	ImFont * AddEmbeddedSdfFont(ImFontAtlas * atlas, FontType type)
+	{
+		// The font itself only rasterizes a space, which provides its metrics
+		return AddEmbeddedFont(atlas, type, SdfFontSize, SdfFontRanges);
+	}
+
+	void AddSdfGlyphRects(ImFontAtlas * atlas, ImFont * font, const ImWchar * ranges)
+	{
+		// Every glyph other than the space gets a rect big enough for its field, placed the same way ImGui places
+		// rasterized glyphs
+		auto config = std::find_if(atlas->ConfigData.begin(), atlas->ConfigData.end(), [font] (const ImFontConfig & config) { return config.DstFont == font; });
+		if (config == atlas->ConfigData.end())
+			return;
+		LoadFontData(*config);
+		stbtt_fontinfo info = {};
+		if (!InitFontInfo(&info, *config))
+			return;
+		const float scale = stbtt_ScaleForPixelHeight(&info, SdfFontSize);
+		int unscaledAscent = 0;
+		int unscaledDescent = 0;
+		int unscaledLineGap = 0;
+		stbtt_GetFontVMetrics(&info, &unscaledAscent, &unscaledDescent, &unscaledLineGap);
+		const float ascent = std::floor(unscaledAscent * scale + ((unscaledAscent > 0) ? 1.0f : -1.0f));
+		for (ranges = ranges ? ranges : atlas->GetGlyphRangesDefault(); ranges[0]; ranges += 2)
+		{
+			for (unsigned int codepoint = ranges[0]; codepoint <= ranges[1]; ++codepoint)
+			{
+				const int glyph = stbtt_FindGlyphIndex(&info, static_cast<int>(codepoint));
+				if (codepoint == SdfFontRanges[0] || !glyph)
+					continue;
+				int x0 = 0;
+				int y0 = 0;
+				int x1 = 0;
+				int y1 = 0;
+				int advance = 0;
+				int leftBearing = 0;
+				stbtt_GetGlyphBitmapBox(&info, glyph, scale, scale, &x0, &y0, &x1, &y1);
+				stbtt_GetGlyphHMetrics(&info, glyph, &advance, &leftBearing);
+				const ImVec2 offset(static_cast<float>(x0 - SdfFontSpread), ascent + static_cast<float>(y0 - SdfFontSpread));
+				atlas->AddCustomRectFontGlyph(font, static_cast<ImWchar>(codepoint), x1 - x0 + SdfFontSpread * 2, y1 - y0 + SdfFontSpread * 2,
+					advance * scale, offset);
+			}
+		}
+	}
+
+	ImFont * AddScaledSdfFont(ImFontAtlas * atlas, const ImFont * font, float pixelSize)
+	{
+		const float scale = pixelSize / font->FontSize;
+		ImFont * scaled = IM_NEW(ImFont);
+		scaled->FontSize = pixelSize;
+		scaled->ContainerAtlas = atlas;
+		scaled->ConfigData = font->ConfigData;
+		scaled->ConfigDataCount = font->ConfigDataCount;
+		scaled->FallbackChar = font->FallbackChar;
+		scaled->EllipsisChar = font->EllipsisChar;
+		scaled->DotChar = font->DotChar;
+		scaled->Ascent = font->Ascent * scale;
+		scaled->Descent = font->Descent * scale;
+		scaled->MetricsTotalSurface = font->MetricsTotalSurface;
+		scaled->Glyphs = font->Glyphs;
+		for (auto & glyph : scaled->Glyphs)
+		{
+			glyph.X0 *= scale;
+			glyph.Y0 *= scale;
+			glyph.X1 *= scale;
+			glyph.Y1 *= scale;
+			glyph.AdvanceX *= scale;
+		}
+		scaled->BuildLookupTable();
+		atlas->Fonts.push_back(scaled);
+		return scaled;
+	}
+
+	bool BakeGlyphs(ImFontAtlas * atlas, const ImWchar * codepoints, size_t count, bool sdf, AtlasRegion & dirty)
+	{
+		if (!atlas->TexPixelsAlpha8 || atlas->TexPixelsUseColors)
+			return false;
+
+		// Fill rows left to right, starting below everything already in the atlas
+		const int padding = atlas->TexGlyphPadding;
+		int top = 0;
+		for (const ImFont * font : atlas->Fonts)
+		{
+			for (const auto & glyph : font->Glyphs)
+				top = std::max(top, static_cast<int>(std::ceil(glyph.V1 * atlas->TexHeight)));
+		}
+		for (const auto & rect : atlas->CustomRects)
+		{
+			if (rect.IsPacked())
+				top = std::max(top, rect.Y + rect.Height);
+		}
+		int rowX = 0;
+		int rowY = top + padding;
+		int rowHeight = 0;
+		auto place = [&] (int width, int height, int & x, int & y)
+		{
+			if (rowX + width > atlas->TexWidth)
+			{
+				rowX = 0;
+				rowY += rowHeight + padding;
+				rowHeight = 0;
+			}
+			if (width > atlas->TexWidth || rowY + height > atlas->TexHeight)
+				return false;
+			x = rowX;
+			y = rowY;
+			rowX += width + padding;
+			rowHeight = std::max(rowHeight, height);
+			return true;
+		};
+
+		// Each font config is a base font.  With SDF fonts, scaled copies share its config.
+		bool complete = true;
+		for (auto & config : atlas->ConfigData)
+		{
+			ImFont * font = config.DstFont;
+			if (!font || !complete)
+				continue;
+			LoadFontData(config);
+			stbtt_fontinfo info = {};
+			if (!InitFontInfo(&info, config))
+				continue;
+			std::vector<ImFont *> targets;
+			for (ImFont * target : atlas->Fonts)
+			{
+				if (target == font || (sdf && target->ConfigData == &config))
+					targets.push_back(target);
+			}
+			const float scale = stbtt_ScaleForPixelHeight(&info, config.SizePixels);
+			const int oversampleH = sdf ? 1 : std::max(config.OversampleH, 1);
+			const int oversampleV = sdf ? 1 : std::max(config.OversampleV, 1);
+			const float ascent = IM_ROUND(font->Ascent);
+			bool added = false;
+			for (size_t i = 0; i < count; ++i)
+			{
+				const ImWchar codepoint = codepoints[i];
+				const int glyph = stbtt_FindGlyphIndex(&info, codepoint);
+				if (!glyph || font->FindGlyphNoFallback(codepoint))
+					continue;
+
+				// Drop the tab glyph, which BuildLookupTable() recreates last
+				if (!added)
+				{
+					for (ImFont * target : targets)
+					{
+						if (!target->Glyphs.empty() && target->Glyphs.back().Codepoint == '\t')
+							target->Glyphs.pop_back();
+					}
+					added = true;
+				}
+
+				int advance = 0;
+				int leftBearing = 0;
+				int x0 = 0;
+				int y0 = 0;
+				int x1 = 0;
+				int y1 = 0;
+				stbtt_GetGlyphHMetrics(&info, glyph, &advance, &leftBearing);
+				stbtt_GetGlyphBitmapBox(&info, glyph, scale * oversampleH, scale * oversampleV, &x0, &y0, &x1, &y1);
+				const int spread = sdf ? SdfFontSpread : 0;
+				const int width = x1 - x0 + oversampleH - 1 + spread * 2;
+				const int height = y1 - y0 + oversampleV - 1 + spread * 2;
+				ImVec4 quad(0.0f, 0.0f, 0.0f, 0.0f);
+				ImVec4 uv(0.0f, 0.0f, 0.0f, 0.0f);
+				if (x1 > x0 && y1 > y0)
+				{
+					int x = 0;
+					int y = 0;
+					if (!place(width, height, x, y))
+					{
+						complete = false;
+						break;
+					}
+					unsigned char * pixels = atlas->TexPixelsAlpha8 + y * atlas->TexWidth + x;
+					if (sdf)
+					{
+						int fieldWidth = 0;
+						int fieldHeight = 0;
+						int xOffset = 0;
+						int yOffset = 0;
+						unsigned char * field = stbtt_GetGlyphSDF(&info, scale, glyph, SdfFontSpread, 128, 128.0f / SdfFontSpread, &fieldWidth, &fieldHeight, &xOffset, &yOffset);
+						if (field)
+						{
+							for (int row = 0; row < std::min(fieldHeight, height); ++row)
+								std::memcpy(pixels + row * atlas->TexWidth, field + row * fieldWidth, std::min(fieldWidth, width));
+							stbtt_FreeSDF(field, nullptr);
+						}
+						quad = ImVec4(static_cast<float>(x0 - spread), ascent + static_cast<float>(y0 - spread), 0.0f, 0.0f);
+					}
+					else
+					{
+						float subX = 0.0f;
+						float subY = 0.0f;
+						stbtt_MakeGlyphBitmapSubpixelPrefilter(&info, pixels, width, height, atlas->TexWidth, scale * oversampleH, scale * oversampleV,
+							0.0f, 0.0f, oversampleH, oversampleV, &subX, &subY, glyph);
+						if (config.RasterizerMultiply != 1.0f)
+						{
+							for (int row = 0; row < height; ++row)
+							{
+								for (int column = 0; column < width; ++column)
+								{
+									unsigned char & pixel = pixels[row * atlas->TexWidth + column];
+									pixel = static_cast<unsigned char>(std::min(pixel * config.RasterizerMultiply, 255.0f));
+								}
+							}
+						}
+						quad = ImVec4(static_cast<float>(x0) / oversampleH + subX + config.GlyphOffset.x, static_cast<float>(y0) / oversampleV + subY + config.GlyphOffset.y + ascent, 0.0f, 0.0f);
+					}
+					quad.z = quad.x + static_cast<float>(width) / oversampleH;
+					quad.w = quad.y + static_cast<float>(height) / oversampleV;
+					uv = ImVec4(x * atlas->TexUvScale.x, y * atlas->TexUvScale.y, (x + width) * atlas->TexUvScale.x, (y + height) * atlas->TexUvScale.y);
+					dirty.Add(x, y, width, height);
+				}
+
+				// Regular glyphs get the same adjustments from their config as when built, while distance fields
+				// are positioned directly, and scaled for each copy
+				for (ImFont * target : targets)
+				{
+					const float targetScale = target->FontSize / font->FontSize;
+					target->AddGlyph(sdf ? nullptr : &config, codepoint, quad.x * targetScale, quad.y * targetScale, quad.z * targetScale, quad.w * targetScale,
+						uv.x, uv.y, uv.z, uv.w, advance * scale * targetScale);
+				}
+			}
+			if (added)
+			{
+				for (ImFont * target : targets)
+					target->BuildLookupTable();
+			}
+		}
+
+		// Keep the RGBA copy used for uploads in step
+		if (atlas->TexPixelsRGBA32 && !dirty.IsEmpty())
+		{
+			for (int y = dirty.y0; y < dirty.y1; ++y)
+			{
+				for (int x = dirty.x0; x < dirty.x1; ++x)
+					atlas->TexPixelsRGBA32[y * atlas->TexWidth + x] = IM_COL32(255, 255, 255, atlas->TexPixelsAlpha8[y * atlas->TexWidth + x]);
+			}
+		}
+		return complete;
+	}
+
+	bool GrowFontAtlas(ImFontAtlas * atlas)
+	{
+		if (!atlas->TexPixelsAlpha8 || atlas->TexPixelsUseColors || atlas->TexHeight * 2 > MaxFontAtlasHeight)
+			return false;
+		const size_t size = static_cast<size_t>(atlas->TexWidth) * atlas->TexHeight;
+		auto pixels = static_cast<unsigned char *>(IM_ALLOC(size * 2));
+		std::memcpy(pixels, atlas->TexPixelsAlpha8, size);
+		std::memset(pixels + size, 0, size);
+		atlas->ClearTexData();
+		atlas->TexPixelsAlpha8 = pixels;
+		atlas->TexHeight *= 2;
+
+		// Texture coordinates are normalized, so everything already in the atlas moves up
+		atlas->TexUvScale.y = 1.0f / atlas->TexHeight;
+		atlas->TexUvWhitePixel.y *= 0.5f;
+		for (auto & uv : atlas->TexUvLines)
+		{
+			uv.y *= 0.5f;
+			uv.w *= 0.5f;
+		}
+		for (ImFont * font : atlas->Fonts)
+		{
+			for (auto & glyph : font->Glyphs)
+			{
+				glyph.V0 *= 0.5f;
+				glyph.V1 *= 0.5f;
+			}
+		}
+		return true;
+	}
+
+	bool LoadFontAtlas(ImFontAtlas * atlas, uint64_t key, const std::filesystem::path & cacheFolder)
+	{
+		return LoadAtlas(atlas, key, GetCachePath(cacheFolder, key));
+	}
+
+	void BuildFontAtlas(ImFontAtlas * atlas, uint64_t key, const std::filesystem::path & cacheFolder)
+	{
+		for (auto & config : atlas->ConfigData)
+			LoadFontData(config);
+		atlas->Build();
+		RenderSdfGlyphs(atlas);
+		SaveAtlas(atlas, key, GetCachePath(cacheFolder, key));
+		PruneCache(cacheFolder);
+	}
+
+	FontAtlasBuild::~FontAtlasBuild()
+	{
+		if (atlas)
+			IM_DELETE(atlas);
+		if (sdfAtlas)
+			IM_DELETE(sdfAtlas);
+	}
+
+	ImFont * FontAtlasBuild::FindFont(FontType type, float pixelSize) const
+	{
+		for (size_t i = 0; i < requested.size() && i < fonts.size(); ++i)
+		{
+			if (requested[i].first == type && requested[i].second == pixelSize)
+				return fonts[i];
+		}
+		return nullptr;
+	}
+
+	void BuildEmbeddedFonts(FontAtlasBuild & build, const std::filesystem::path & cacheFolder)
+	{
+		unsigned char * pixels = nullptr;
+		int width = 0;
+		int height = 0;
+		build.atlas = IM_NEW(ImFontAtlas);
+		AddDefaultFont(build.atlas);
+		const ImWchar * ranges = nullptr;
+		if (!build.extraGlyphs.empty())
+		{
+			ImFontGlyphRangesBuilder builder;
+			builder.AddRanges(build.atlas->GetGlyphRangesDefault());
+			for (ImWchar codepoint : build.extraGlyphs)
+				builder.AddChar(codepoint);
+			builder.BuildRanges(&build.glyphRanges);
+			ranges = build.glyphRanges.Data;
+		}
+		if (!build.sdf)
+		{
+			for (const auto & font : build.requested)
+				build.fonts.push_back(AddEmbeddedFont(build.atlas, font.first, font.second, ranges));
+			const uint64_t key = GetAtlasKey(build.requested, ranges, false);
+			if (!LoadFontAtlas(build.atlas, key, cacheFolder))
+				BuildFontAtlas(build.atlas, key, cacheFolder);
+			build.atlas->GetTexDataAsRGBA32(&pixels, &width, &height);
+			return;
+		}
+		const uint64_t key = GetAtlasKey({}, nullptr, false);
+		if (!LoadFontAtlas(build.atlas, key, cacheFolder))
+			BuildFontAtlas(build.atlas, key, cacheFolder);
+		build.atlas->GetTexDataAsRGBA32(&pixels, &width, &height);
+
+		// Everything drawn with the SDF atlas goes through the SDF shader path, so skip the extras that would
+		// need regular sampling.  One font per type is keyed at the SDF size.
+		build.sdfAtlas = IM_NEW(ImFontAtlas);
+		build.sdfAtlas->Flags |= ImFontAtlasFlags_NoBakedLines | ImFontAtlasFlags_NoMouseCursors;
+		std::vector<std::pair<FontType, float>> sdfTypes;
+		std::unordered_map<FontType, ImFont *> sdfFonts;
+		for (const auto & font : build.requested)
+		{
+			if (sdfFonts.count(font.first))
+				continue;
+			sdfFonts[font.first] = AddEmbeddedSdfFont(build.sdfAtlas, font.first);
+			sdfTypes.emplace_back(font.first, SdfFontSize);
+		}
+		const uint64_t sdfKey = GetAtlasKey(sdfTypes, ranges, true);
+		if (!LoadFontAtlas(build.sdfAtlas, sdfKey, cacheFolder))
+		{
+			for (const auto & type : sdfTypes)
+				AddSdfGlyphRects(build.sdfAtlas, sdfFonts[type.first], ranges);
+			BuildFontAtlas(build.sdfAtlas, sdfKey, cacheFolder);
+		}
+		for (const auto & font : build.requested)
+			build.fonts.push_back(AddScaledSdfFont(build.sdfAtlas, sdfFonts[font.first], font.second));
+		build.sdfAtlas->GetTexDataAsRGBA32(&pixels, &width, &height);
+	}
+
+}
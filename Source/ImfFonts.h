@@ -0,0 +1,101 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2021 James Boer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#pragma once
+
+
+namespace ImFrame
+{
+
+	// Adds ImGui's default font, or one of the embedded fonts, to the atlas without building it.  Font data is
+	// only decompressed when the atlas is built or glyphs are baked, not when it's loaded from the cache.
+	// Ranges default to ImGui's, and must outlive the atlas.
+	ImFont * AddDefaultFont(ImFontAtlas * atlas);
+	ImFont * AddEmbeddedFont(ImFontAtlas * atlas, FontType type, float pixelSize, const ImWchar * ranges = nullptr);
+
+	// Adds one of the embedded fonts to the atlas as signed distance fields, rasterized at SdfFontSize when the
+	// atlas is built.  Its glyphs are custom rects, added by AddSdfGlyphRects() before a build, which
+	// BuildFontAtlas() fills with distance fields.
+	ImFont * AddEmbeddedSdfFont(ImFontAtlas * atlas, FontType type);
+	void AddSdfGlyphRects(ImFontAtlas * atlas, ImFont * font, const ImWchar * ranges = nullptr);
+
+	// Adds a copy of a built SDF font at another size, sharing its glyphs in the atlas texture
+	ImFont * AddScaledSdfFont(ImFontAtlas * atlas, const ImFont * font, float pixelSize);
+
+	// Restores the atlas from the cache folder if the same fonts were built before under this key, given the
+	// same fonts added to it.  Otherwise builds it from them, writing the result back to the cache, which keeps
+	// only the most recently used atlases.
+	bool LoadFontAtlas(ImFontAtlas * atlas, uint64_t key, const std::filesystem::path & cacheFolder);
+	void BuildFontAtlas(ImFontAtlas * atlas, uint64_t key, const std::filesystem::path & cacheFolder);
+
+	// Part of an atlas texture changed since it was uploaded
+	struct AtlasRegion
+	{
+		void Add(int x, int y, int width, int height)
+		{
+			x0 = std::min(x0, x);
+			y0 = std::min(y0, y);
+			x1 = std::max(x1, x + width);
+			y1 = std::max(y1, y + height);
+		}
+		bool IsEmpty() const { return x1 <= x0 || y1 <= y0; }
+		int x0 = std::numeric_limits<int>::max();
+		int y0 = std::numeric_limits<int>::max();
+		int x1 = 0;
+		int y1 = 0;
+	};
+
+	// Rasterizes glyphs for codepoints a built atlas lacks into the free rows below its existing glyphs, and
+	// adds them to every font in it that has them.  With sdf set, glyphs are distance fields, which copies made
+	// by AddScaledSdfFont() get too.  Returns false once the atlas is full, leaving the rest for a rebuild.
+	bool BakeGlyphs(ImFontAtlas * atlas, const ImWchar * codepoints, size_t count, bool sdf, AtlasRegion & dirty);
+
+	// Doubles the height of a built atlas to make room for more glyphs, keeping its contents.  The whole texture
+	// needs uploading again.  Returns false once the atlas is as tall as it's allowed to get.
+	bool GrowFontAtlas(ImFontAtlas * atlas);
+
+	// Atlas of ImGui's default font followed by the requested embedded fonts, in order.  With sdf set, the
+	// embedded fonts go in a separate atlas of distance fields instead, with one set of glyphs per font type
+	// shared by every size.  Extra glyphs are added to the default ranges, which must outlive the atlases.
+	// Atlases are deleted along with the build unless taken.
+	struct FontAtlasBuild
+	{
+		~FontAtlasBuild();
+		ImFont * FindFont(FontType type, float pixelSize) const;
+		std::vector<std::pair<FontType, float>> requested;
+		std::vector<ImWchar> extraGlyphs;
+		ImVector<ImWchar> glyphRanges;
+		std::vector<ImFont *> fonts;
+		ImFontAtlas * atlas = nullptr;
+		ImFontAtlas * sdfAtlas = nullptr;
+		bool sdf = false;
+		std::atomic<bool> complete = false;
+	};
+	using FontAtlasBuildPtr = std::shared_ptr<FontAtlasBuild>;
+
+	// Builds a new atlas without touching ImGui's, so it can run on a worker thread.  The texture data is
+	// converted to RGBA too, leaving only the upload for the main thread.
+	void BuildEmbeddedFonts(FontAtlasBuild & build, const std::filesystem::path & cacheFolder);
+
+}
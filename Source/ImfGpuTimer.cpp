@@ -0,0 +1,81 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2021 James Boer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include "ImfInternal.h"
+
+namespace ImFrame
+{
+
+	void GpuTimer::Begin()
+	{
+		if (!IsGpuTimerSupported())
+			return;
+		if (!m_created)
+		{
+			glGenQueries(QueryFrames * 2, &m_queries[0][0]);
+			m_created = true;
+		}
+
+		// Read back the oldest query pair if the GPU has finished with it.  If not, skip timing this
+		// frame rather than waiting for the results.
+		if (m_pending[m_index])
+		{
+			GLint available = 0;
+			glGetQueryObjectiv(m_queries[m_index][1], GL_QUERY_RESULT_AVAILABLE, &available);
+			if (!available)
+				return;
+			GLuint64 start = 0;
+			GLuint64 end = 0;
+			glGetQueryObjectui64v(m_queries[m_index][0], GL_QUERY_RESULT, &start);
+			glGetQueryObjectui64v(m_queries[m_index][1], GL_QUERY_RESULT, &end);
+			m_milliseconds = static_cast<float>(static_cast<double>(end - start) / 1000000.0);
+			m_pending[m_index] = false;
+		}
+		glQueryCounter(m_queries[m_index][0], GL_TIMESTAMP);
+		m_active = true;
+	}
+
+	void GpuTimer::End()
+	{
+		if (!m_active)
+			return;
+		glQueryCounter(m_queries[m_index][1], GL_TIMESTAMP);
+		m_pending[m_index] = true;
+		m_index = (m_index + 1) % QueryFrames;
+		m_active = false;
+	}
+
+	void GpuTimer::Destroy()
+	{
+		if (m_created)
+			glDeleteQueries(QueryFrames * 2, &m_queries[0][0]);
+		*this = GpuTimer();
+	}
+
+	bool IsGpuTimerSupported()
+	{
+		return GLAD_GL_ARB_timer_query || (GLVersion.major * 10 + GLVersion.minor) >= 33;
+	}
+
+}
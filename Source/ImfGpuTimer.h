@@ -0,0 +1,55 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2021 James Boer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#pragma once
+
+
+namespace ImFrame
+{
+
+	// Measures GPU time between Begin() and End() using timestamp query pairs.  Queries are triple-buffered
+	// and only read back once available, so reading results never stalls the pipeline.  Query objects aren't
+	// shared between contexts, so each timer must only be used with the context that was current when it
+	// first began.
+	class GpuTimer
+	{
+	public:
+		void Begin();
+		void End();
+		void Destroy();
+		float GetMilliseconds() const { return m_milliseconds; }
+
+	private:
+		static const int QueryFrames = 3;
+		GLuint m_queries[QueryFrames][2] = {};
+		bool m_pending[QueryFrames] = {};
+		int m_index = 0;
+		bool m_created = false;
+		bool m_active = false;
+		float m_milliseconds = 0.0f;
+	};
+
+	bool IsGpuTimerSupported();
+
+}
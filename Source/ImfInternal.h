@@ -30,11 +30,34 @@ THE SOFTWARE.
 #include <string>
 #include <filesystem>
 #include <cassert>
+#include <atomic>
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <cstring>
+#include <utility>
+#include <fstream>
+#include <limits>
+#include <variant>
+
+#include "ImfConfig.h"
+#include "ImfFonts.h"
+#include "ImfGpuTimer.h"
+#include "ImfTextureCodec.h"
+#include "ImfTextures.h"
+#include "ImfTiledImage.h"
+#include "ImfThreadPool.h"
 
 #include <Tbl.hpp>
 #include <mini/ini.h>
 #include <nfd.hpp>
 #include <stb_image.h>
+#include <stb_image_into.h>
+#include <stb_image_resize.h>
 
 #include "ImGui/imgui_impl_glfw.h"
 #include "ImGui/imgui_impl_opengl3.h"
@@ -46,6 +69,12 @@ namespace ImFrame
 	std::filesystem::path OsGetExecutableFolder();
 	std::filesystem::path OsGetResourceFolder();
 	void * OsGetNativeWindow(GLFWwindow * window);
+	const void * OsMapFile(const std::filesystem::path & path, size_t & size);
+	void OsUnmapFile(const void * data, size_t size);
+	intptr_t OsCreateTempFile();
+	void OsCloseFile(intptr_t file);
+	bool OsWriteFile(intptr_t file, uint64_t offset, const void * data, size_t size);
+	bool OsReadFile(intptr_t file, uint64_t offset, void * data, size_t size);
 
     void OsInitialize();
     void OsShutDown();
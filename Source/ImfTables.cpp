@@ -0,0 +1,113 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2021 James Boer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include "ImfInternal.h"
+
+namespace ImFrame
+{
+
+	// The mapped file is declared first, so it's mapped before the table parses it, and unmapped after
+	struct Table
+	{
+		explicit Table(MappedFile && mappedFile) :
+			file(std::move(mappedFile)),
+			data(std::string_view(file.GetData(), file.GetSize()), std::thread::hardware_concurrency())
+		{
+		}
+
+		MappedFile file;
+		Tbl::TableView data;
+	};
+
+	TablePtr LoadTable(const char * filename)
+	{
+		auto table = std::make_shared<Table>(MappedFile(filename));
+		if (!table->data)
+			return nullptr;
+		return table;
+	}
+
+	size_t GetTableRowCount(const TablePtr & table)
+	{
+		assert(table);
+		return table->data.GetNumRows();
+	}
+
+	size_t GetTableColumnCount(const TablePtr & table)
+	{
+		assert(table);
+		return table->data.GetNumColumns();
+	}
+
+	std::optional<size_t> FindTableRow(const TablePtr & table, std::string_view rowName)
+	{
+		assert(table);
+		if (!table->data.HasRow(rowName))
+			return std::nullopt;
+		return table->data.GetRowIndex(rowName);
+	}
+
+	std::optional<size_t> FindTableColumn(const TablePtr & table, std::string_view columnName)
+	{
+		assert(table);
+		if (!table->data.HasColumn(columnName))
+			return std::nullopt;
+		return table->data.GetColumnIndex(columnName);
+	}
+
+	TableCell GetTableCell(const TablePtr & table, size_t row, size_t column)
+	{
+		assert(table);
+		return table->data.GetData(row, column);
+	}
+
+	TableColumnType GetTableColumnType(const TablePtr & table, size_t column)
+	{
+		assert(table);
+		switch (table->data.GetColumnType(column))
+		{
+			case Tbl::IntType:
+				return TableColumnType::Int;
+			case Tbl::DoubleType:
+				return TableColumnType::Double;
+			default:
+				return TableColumnType::String;
+		}
+	}
+
+	Span<const int64_t> GetTableIntColumn(const TablePtr & table, size_t column)
+	{
+		assert(table);
+		auto values = table->data.GetIntColumn(column);
+		return Span<const int64_t>(values.data(), values.size());
+	}
+
+	Span<const double> GetTableDoubleColumn(const TablePtr & table, size_t column)
+	{
+		assert(table);
+		auto values = table->data.GetDoubleColumn(column);
+		return Span<const double>(values.data(), values.size());
+	}
+
+}
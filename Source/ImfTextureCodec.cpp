@@ -0,0 +1,758 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2021 James Boer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include "ImfTextureCodec.h"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+namespace ImFrame
+{
+
+	namespace
+	{
+
+		// DDS header fields, as byte offsets from the start of the file
+		const uint32_t DdsMagic = 0x20534444;
+		const size_t DdsFlagsOffset = 8;
+		const size_t DdsHeightOffset = 12;
+		const size_t DdsWidthOffset = 16;
+		const size_t DdsMipCountOffset = 28;
+		const size_t DdsFourCCOffset = 84;
+		const size_t DdsHeaderSize = 128;
+		const size_t DdsDx10FormatOffset = 128;
+		const size_t DdsDx10HeaderSize = 20;
+		const uint32_t DdsFlagMipCount = 0x20000;
+
+		// DXGI formats found in DX10 headers
+		const uint32_t DxgiBC1 = 71;
+		const uint32_t DxgiBC1Srgb = 72;
+		const uint32_t DxgiBC3 = 77;
+		const uint32_t DxgiBC3Srgb = 78;
+		const uint32_t DxgiBC7 = 98;
+		const uint32_t DxgiBC7Srgb = 99;
+
+		// KTX header fields, as byte offsets from the start of the file
+		const uint8_t KtxIdentifier[12] = { 0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n' };
+		const size_t KtxEndiannessOffset = 12;
+		const size_t KtxInternalFormatOffset = 28;
+		const size_t KtxWidthOffset = 36;
+		const size_t KtxHeightOffset = 40;
+		const size_t KtxDepthOffset = 44;
+		const size_t KtxArrayCountOffset = 48;
+		const size_t KtxFaceCountOffset = 52;
+		const size_t KtxMipCountOffset = 56;
+		const size_t KtxKeyValueSizeOffset = 60;
+		const size_t KtxHeaderSize = 64;
+
+		// OpenGL internal formats found in KTX headers
+		const uint32_t GlCompressedRgbDxt1 = 0x83F0;
+		const uint32_t GlCompressedRgbaDxt1 = 0x83F1;
+		const uint32_t GlCompressedRgbaDxt5 = 0x83F3;
+		const uint32_t GlCompressedSrgbDxt1 = 0x8C4C;
+		const uint32_t GlCompressedSrgbAlphaDxt1 = 0x8C4D;
+		const uint32_t GlCompressedSrgbAlphaDxt5 = 0x8C4F;
+		const uint32_t GlCompressedRgbaBptc = 0x8E8C;
+		const uint32_t GlCompressedSrgbAlphaBptc = 0x8E8D;
+
+		uint32_t MakeFourCC(char a, char b, char c, char d)
+		{
+			return static_cast<uint32_t>(a) | (static_cast<uint32_t>(b) << 8) | (static_cast<uint32_t>(c) << 16) | (static_cast<uint32_t>(d) << 24);
+		}
+
+		uint32_t ReadUInt32(const std::vector<uint8_t> & file, size_t offset)
+		{
+			return static_cast<uint32_t>(file[offset]) | (static_cast<uint32_t>(file[offset + 1]) << 8) |
+				(static_cast<uint32_t>(file[offset + 2]) << 16) | (static_cast<uint32_t>(file[offset + 3]) << 24);
+		}
+
+		void WriteUInt32(std::vector<uint8_t> & file, size_t offset, uint32_t value)
+		{
+			for (int i = 0; i < 4; ++i)
+				file[offset + i] = static_cast<uint8_t>(value >> (i * 8));
+		}
+
+		size_t GetBlockSize(BlockFormat format)
+		{
+			return format == BlockFormat::BC1 ? 8 : 16;
+		}
+
+		// A full mip chain ends at 1x1, so header mip counts are limited to that.  GL rejects levels past it,
+		// and shifting the size by 32 or more is undefined.
+		int ClampLevelCount(uint32_t levelCount, int width, int height)
+		{
+			uint32_t maxLevelCount = 1;
+			for (int size = std::max(width, height); size > 1; size >>= 1)
+				++maxLevelCount;
+			return static_cast<int>(std::clamp<uint32_t>(levelCount, 1, maxLevelCount));
+		}
+
+		// Splits level data following the header into the base level and its mips, each half the size of the last
+		bool ReadLevels(const std::vector<uint8_t> & file, size_t offset, int width, int height, int levelCount, CompressedImage & image)
+		{
+			if (width <= 0 || height <= 0)
+				return false;
+			for (int level = 0; level < levelCount; ++level)
+			{
+				CompressedLevel compressedLevel;
+				compressedLevel.width = std::max(1, width >> level);
+				compressedLevel.height = std::max(1, height >> level);
+				const size_t size = GetCompressedSize(image.format, compressedLevel.width, compressedLevel.height);
+				if (offset + size > file.size())
+					return false;
+				compressedLevel.data.assign(file.begin() + offset, file.begin() + offset + size);
+				image.levels.push_back(std::move(compressedLevel));
+				offset += size;
+			}
+			return true;
+		}
+
+		std::optional<CompressedImage> ReadDds(const std::vector<uint8_t> & file)
+		{
+			if (file.size() < DdsHeaderSize || ReadUInt32(file, 0) != DdsMagic)
+				return std::optional<CompressedImage>();
+			CompressedImage image;
+			size_t offset = DdsHeaderSize;
+			const uint32_t fourCC = ReadUInt32(file, DdsFourCCOffset);
+			if (fourCC == MakeFourCC('D', 'X', 'T', '1'))
+				image.format = BlockFormat::BC1;
+			else if (fourCC == MakeFourCC('D', 'X', 'T', '5'))
+				image.format = BlockFormat::BC3;
+			else if (fourCC == MakeFourCC('D', 'X', '1', '0') && file.size() >= DdsHeaderSize + DdsDx10HeaderSize)
+			{
+				const uint32_t format = ReadUInt32(file, DdsDx10FormatOffset);
+				if (format == DxgiBC1 || format == DxgiBC1Srgb)
+					image.format = BlockFormat::BC1;
+				else if (format == DxgiBC3 || format == DxgiBC3Srgb)
+					image.format = BlockFormat::BC3;
+				else if (format == DxgiBC7 || format == DxgiBC7Srgb)
+					image.format = BlockFormat::BC7;
+				else
+					return std::optional<CompressedImage>();
+				offset += DdsDx10HeaderSize;
+			}
+			else
+				return std::optional<CompressedImage>();
+			const int width = static_cast<int>(ReadUInt32(file, DdsWidthOffset));
+			const int height = static_cast<int>(ReadUInt32(file, DdsHeightOffset));
+			const uint32_t mipCount = (ReadUInt32(file, DdsFlagsOffset) & DdsFlagMipCount) ? ReadUInt32(file, DdsMipCountOffset) : 1;
+			const int levelCount = ClampLevelCount(mipCount, width, height);
+			if (!ReadLevels(file, offset, width, height, levelCount, image))
+				return std::optional<CompressedImage>();
+			return image;
+		}
+
+		// Only little endian, single face 2D textures are supported.  Each level is preceded by its size.
+		std::optional<CompressedImage> ReadKtx(const std::vector<uint8_t> & file)
+		{
+			if (file.size() < KtxHeaderSize || !std::equal(std::begin(KtxIdentifier), std::end(KtxIdentifier), file.begin()) ||
+				ReadUInt32(file, KtxEndiannessOffset) != 0x04030201 || ReadUInt32(file, KtxDepthOffset) > 1 ||
+				ReadUInt32(file, KtxArrayCountOffset) > 1 || ReadUInt32(file, KtxFaceCountOffset) != 1)
+				return std::optional<CompressedImage>();
+			CompressedImage image;
+			switch (ReadUInt32(file, KtxInternalFormatOffset))
+			{
+				case GlCompressedRgbDxt1:
+				case GlCompressedRgbaDxt1:
+				case GlCompressedSrgbDxt1:
+				case GlCompressedSrgbAlphaDxt1:
+					image.format = BlockFormat::BC1;
+					break;
+				case GlCompressedRgbaDxt5:
+				case GlCompressedSrgbAlphaDxt5:
+					image.format = BlockFormat::BC3;
+					break;
+				case GlCompressedRgbaBptc:
+				case GlCompressedSrgbAlphaBptc:
+					image.format = BlockFormat::BC7;
+					break;
+				default:
+					return std::optional<CompressedImage>();
+			}
+			const int width = static_cast<int>(ReadUInt32(file, KtxWidthOffset));
+			const int height = static_cast<int>(ReadUInt32(file, KtxHeightOffset));
+			const int levelCount = ClampLevelCount(ReadUInt32(file, KtxMipCountOffset), width, height);
+			size_t offset = KtxHeaderSize + ReadUInt32(file, KtxKeyValueSizeOffset);
+			for (int level = 0; level < levelCount; ++level)
+			{
+				if (offset + 4 > file.size())
+					return std::optional<CompressedImage>();
+				const size_t size = ReadUInt32(file, offset);
+				if (!ReadLevels(file, offset + 4, std::max(1, width >> level), std::max(1, height >> level), 1, image) ||
+					image.levels.back().data.size() != size)
+					return std::optional<CompressedImage>();
+				offset = (offset + 4 + size + 3) & ~static_cast<size_t>(3);
+			}
+			return image;
+		}
+
+		struct Color
+		{
+			uint8_t r, g, b, a;
+		};
+
+		Color Unpack565(uint16_t value)
+		{
+			const int r = (value >> 11) & 0x1F;
+			const int g = (value >> 5) & 0x3F;
+			const int b = value & 0x1F;
+			return Color{ static_cast<uint8_t>((r << 3) | (r >> 2)), static_cast<uint8_t>((g << 2) | (g >> 4)),
+				static_cast<uint8_t>((b << 3) | (b >> 2)), 255 };
+		}
+
+		uint16_t Pack565(const uint8_t * pixel)
+		{
+			const int r = (pixel[0] * 31 + 127) / 255;
+			const int g = (pixel[1] * 63 + 127) / 255;
+			const int b = (pixel[2] * 31 + 127) / 255;
+			return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+		}
+
+		Color Blend(Color a, Color b, int weightA, int weightB)
+		{
+			const int total = weightA + weightB;
+			return Color{ static_cast<uint8_t>((a.r * weightA + b.r * weightB) / total), static_cast<uint8_t>((a.g * weightA + b.g * weightB) / total),
+				static_cast<uint8_t>((a.b * weightA + b.b * weightB) / total), 255 };
+		}
+
+		// BC1 blocks with the first endpoint not above the second use three colors plus transparent black.  BC3
+		// color blocks always use four colors.
+		void GetColorPalette(const uint8_t * block, bool allowTransparent, Color palette[4])
+		{
+			const uint16_t color0 = static_cast<uint16_t>(block[0] | (block[1] << 8));
+			const uint16_t color1 = static_cast<uint16_t>(block[2] | (block[3] << 8));
+			palette[0] = Unpack565(color0);
+			palette[1] = Unpack565(color1);
+			if (color0 > color1 || !allowTransparent)
+			{
+				palette[2] = Blend(palette[0], palette[1], 2, 1);
+				palette[3] = Blend(palette[0], palette[1], 1, 2);
+			}
+			else
+			{
+				palette[2] = Blend(palette[0], palette[1], 1, 1);
+				palette[3] = Color{ 0, 0, 0, 0 };
+			}
+		}
+
+		void GetAlphaPalette(const uint8_t * block, uint8_t palette[8])
+		{
+			palette[0] = block[0];
+			palette[1] = block[1];
+			if (palette[0] > palette[1])
+			{
+				for (int i = 1; i < 7; ++i)
+					palette[i + 1] = static_cast<uint8_t>(((7 - i) * palette[0] + i * palette[1]) / 7);
+			}
+			else
+			{
+				for (int i = 1; i < 5; ++i)
+					palette[i + 1] = static_cast<uint8_t>(((5 - i) * palette[0] + i * palette[1]) / 5);
+				palette[6] = 0;
+				palette[7] = 255;
+			}
+		}
+
+		void DecodeColorBlock(const uint8_t * block, bool allowTransparent, uint8_t * pixels)
+		{
+			Color palette[4];
+			GetColorPalette(block, allowTransparent, palette);
+			const uint32_t indices = block[4] | (block[5] << 8) | (block[6] << 16) | (static_cast<uint32_t>(block[7]) << 24);
+			for (int i = 0; i < 16; ++i)
+			{
+				const Color & color = palette[(indices >> (i * 2)) & 3];
+				pixels[i * 4 + 0] = color.r;
+				pixels[i * 4 + 1] = color.g;
+				pixels[i * 4 + 2] = color.b;
+				pixels[i * 4 + 3] = color.a;
+			}
+		}
+
+		void DecodeAlphaBlock(const uint8_t * block, uint8_t * pixels)
+		{
+			uint8_t palette[8];
+			GetAlphaPalette(block, palette);
+			uint64_t indices = 0;
+			for (int i = 0; i < 6; ++i)
+				indices |= static_cast<uint64_t>(block[2 + i]) << (i * 8);
+			for (int i = 0; i < 16; ++i)
+				pixels[i * 4 + 3] = palette[(indices >> (i * 3)) & 7];
+		}
+
+		// BC7 modes, from the BPTC specification
+		struct Bc7Mode
+		{
+			int subsets;
+			int partitionBits;
+			int rotationBits;
+			int indexSelectionBits;
+			int colorBits;
+			int alphaBits;
+			int endpointPBits;
+			int sharedPBits;
+			int indexBits;
+			int secondaryIndexBits;
+		};
+
+		const Bc7Mode Bc7Modes[8] =
+		{
+			{ 3, 4, 0, 0, 4, 0, 1, 0, 3, 0 },
+			{ 2, 6, 0, 0, 6, 0, 0, 1, 3, 0 },
+			{ 3, 6, 0, 0, 5, 0, 0, 0, 2, 0 },
+			{ 2, 6, 0, 0, 7, 0, 1, 0, 2, 0 },
+			{ 1, 0, 2, 1, 5, 6, 0, 0, 2, 3 },
+			{ 1, 0, 2, 0, 7, 8, 0, 0, 2, 2 },
+			{ 1, 0, 0, 0, 7, 7, 1, 0, 4, 0 },
+			{ 2, 6, 0, 0, 5, 5, 1, 0, 2, 0 },
+		};
+
+		const uint8_t Bc7Partitions2[64][16] =
+		{
+			{ 0,0,1,1,0,0,1,1,0,0,1,1,0,0,1,1 }, { 0,0,0,1,0,0,0,1,0,0,0,1,0,0,0,1 }, { 0,1,1,1,0,1,1,1,0,1,1,1,0,1,1,1 }, { 0,0,0,1,0,0,1,1,0,0,1,1,0,1,1,1 },
+			{ 0,0,0,0,0,0,0,1,0,0,0,1,0,0,1,1 }, { 0,0,1,1,0,1,1,1,0,1,1,1,1,1,1,1 }, { 0,0,0,1,0,0,1,1,0,1,1,1,1,1,1,1 }, { 0,0,0,0,0,0,0,1,0,0,1,1,0,1,1,1 },
+			{ 0,0,0,0,0,0,0,0,0,0,0,1,0,0,1,1 }, { 0,0,1,1,0,1,1,1,1,1,1,1,1,1,1,1 }, { 0,0,0,0,0,0,0,1,0,1,1,1,1,1,1,1 }, { 0,0,0,0,0,0,0,0,0,0,0,1,0,1,1,1 },
+			{ 0,0,0,1,0,1,1,1,1,1,1,1,1,1,1,1 }, { 0,0,0,0,0,0,0,0,1,1,1,1,1,1,1,1 }, { 0,0,0,0,1,1,1,1,1,1,1,1,1,1,1,1 }, { 0,0,0,0,0,0,0,0,0,0,0,0,1,1,1,1 },
+			{ 0,0,0,0,1,0,0,0,1,1,1,0,1,1,1,1 }, { 0,1,1,1,0,0,0,1,0,0,0,0,0,0,0,0 }, { 0,0,0,0,0,0,0,0,1,0,0,0,1,1,1,0 }, { 0,1,1,1,0,0,1,1,0,0,0,1,0,0,0,0 },
+			{ 0,0,1,1,0,0,0,1,0,0,0,0,0,0,0,0 }, { 0,0,0,0,1,0,0,0,1,1,0,0,1,1,1,0 }, { 0,0,0,0,0,0,0,0,1,0,0,0,1,1,0,0 }, { 0,1,1,1,0,0,1,1,0,0,1,1,0,0,0,1 },
+			{ 0,0,1,1,0,0,0,1,0,0,0,1,0,0,0,0 }, { 0,0,0,0,1,0,0,0,1,0,0,0,1,1,0,0 }, { 0,1,1,0,0,1,1,0,0,1,1,0,0,1,1,0 }, { 0,0,1,1,0,1,1,0,0,1,1,0,1,1,0,0 },
+			{ 0,0,0,1,0,1,1,1,1,1,1,0,1,0,0,0 }, { 0,0,0,0,1,1,1,1,1,1,1,1,0,0,0,0 }, { 0,1,1,1,0,0,0,1,1,0,0,0,1,1,1,0 }, { 0,0,1,1,1,0,0,1,1,0,0,1,1,1,0,0 },
+			{ 0,1,0,1,0,1,0,1,0,1,0,1,0,1,0,1 }, { 0,0,0,0,1,1,1,1,0,0,0,0,1,1,1,1 }, { 0,1,0,1,1,0,1,0,0,1,0,1,1,0,1,0 }, { 0,0,1,1,0,0,1,1,1,1,0,0,1,1,0,0 },
+			{ 0,0,1,1,1,1,0,0,0,0,1,1,1,1,0,0 }, { 0,1,0,1,0,1,0,1,1,0,1,0,1,0,1,0 }, { 0,1,1,0,1,0,0,1,0,1,1,0,1,0,0,1 }, { 0,1,0,1,1,0,1,0,1,0,1,0,0,1,0,1 },
+			{ 0,1,1,1,0,0,1,1,1,1,0,0,1,1,1,0 }, { 0,0,0,1,0,0,1,1,1,1,0,0,1,0,0,0 }, { 0,0,1,1,0,0,1,0,0,1,0,0,1,1,0,0 }, { 0,0,1,1,1,0,1,1,1,1,0,1,1,1,0,0 },
+			{ 0,1,1,0,1,0,0,1,1,0,0,1,0,1,1,0 }, { 0,0,1,1,1,1,0,0,1,1,0,0,0,0,1,1 }, { 0,1,1,0,0,1,1,0,1,0,0,1,1,0,0,1 }, { 0,0,0,0,0,1,1,0,0,1,1,0,0,0,0,0 },
+			{ 0,1,0,0,1,1,1,0,0,1,0,0,0,0,0,0 }, { 0,0,1,0,0,1,1,1,0,0,1,0,0,0,0,0 }, { 0,0,0,0,0,0,1,0,0,1,1,1,0,0,1,0 }, { 0,0,0,0,0,1,0,0,1,1,1,0,0,1,0,0 },
+			{ 0,1,1,0,1,1,0,0,1,0,0,1,0,0,1,1 }, { 0,0,1,1,0,1,1,0,1,1,0,0,1,0,0,1 }, { 0,1,1,0,0,0,1,1,1,0,0,1,1,1,0,0 }, { 0,0,1,1,1,0,0,1,1,1,0,0,0,1,1,0 },
+			{ 0,1,1,0,1,1,0,0,1,1,0,0,1,0,0,1 }, { 0,1,1,0,0,0,1,1,0,0,1,1,1,0,0,1 }, { 0,1,1,1,1,1,1,0,1,0,0,0,0,0,0,1 }, { 0,0,0,1,1,0,0,0,1,1,1,0,0,1,1,1 },
+			{ 0,0,0,0,1,1,1,1,0,0,1,1,0,0,1,1 }, { 0,0,1,1,0,0,1,1,1,1,1,1,0,0,0,0 }, { 0,0,1,0,0,0,1,0,1,1,1,0,1,1,1,0 }, { 0,1,0,0,0,1,0,0,0,1,1,1,0,1,1,1 },
+		};
+
+		const uint8_t Bc7Partitions3[64][16] =
+		{
+			{ 0,0,1,1,0,0,1,1,0,2,2,1,2,2,2,2 }, { 0,0,0,1,0,0,1,1,2,2,1,1,2,2,2,1 }, { 0,0,0,0,2,0,0,1,2,2,1,1,2,2,1,1 }, { 0,2,2,2,0,0,2,2,0,0,1,1,0,1,1,1 },
+			{ 0,0,0,0,0,0,0,0,1,1,2,2,1,1,2,2 }, { 0,0,1,1,0,0,1,1,0,0,2,2,0,0,2,2 }, { 0,0,2,2,0,0,2,2,1,1,1,1,1,1,1,1 }, { 0,0,1,1,0,0,1,1,2,2,1,1,2,2,1,1 },
+			{ 0,0,0,0,0,0,0,0,1,1,1,1,2,2,2,2 }, { 0,0,0,0,1,1,1,1,1,1,1,1,2,2,2,2 }, { 0,0,0,0,1,1,1,1,2,2,2,2,2,2,2,2 }, { 0,0,1,2,0,0,1,2,0,0,1,2,0,0,1,2 },
+			{ 0,1,1,2,0,1,1,2,0,1,1,2,0,1,1,2 }, { 0,1,2,2,0,1,2,2,0,1,2,2,0,1,2,2 }, { 0,0,1,1,0,1,1,2,1,1,2,2,1,2,2,2 }, { 0,0,1,1,2,0,0,1,2,2,0,0,2,2,2,0 },
+			{ 0,0,0,1,0,0,1,1,0,1,1,2,1,1,2,2 }, { 0,1,1,1,0,0,1,1,2,0,0,1,2,2,0,0 }, { 0,0,0,0,1,1,2,2,1,1,2,2,1,1,2,2 }, { 0,0,2,2,0,0,2,2,0,0,2,2,1,1,1,1 },
+			{ 0,1,1,1,0,1,1,1,0,2,2,2,0,2,2,2 }, { 0,0,0,1,0,0,0,1,2,2,2,1,2,2,2,1 }, { 0,0,0,0,0,0,1,1,0,1,2,2,0,1,2,2 }, { 0,0,0,0,1,1,0,0,2,2,1,0,2,2,1,0 },
+			{ 0,1,2,2,0,1,2,2,0,0,1,1,0,0,0,0 }, { 0,0,1,2,0,0,1,2,1,1,2,2,2,2,2,2 }, { 0,1,1,0,1,2,2,1,1,2,2,1,0,1,1,0 }, { 0,0,0,0,0,1,1,0,1,2,2,1,1,2,2,1 },
+			{ 0,0,2,2,1,1,0,2,1,1,0,2,0,0,2,2 }, { 0,1,1,0,0,1,1,0,2,0,0,2,2,2,2,2 }, { 0,0,1,1,0,1,2,2,0,1,2,2,0,0,1,1 }, { 0,0,0,0,2,0,0,0,2,2,1,1,2,2,2,1 },
+			{ 0,0,0,0,0,0,0,2,1,1,2,2,1,2,2,2 }, { 0,2,2,2,0,0,2,2,0,0,1,2,0,0,1,1 }, { 0,0,1,1,0,0,1,2,0,0,2,2,0,2,2,2 }, { 0,1,2,0,0,1,2,0,0,1,2,0,0,1,2,0 },
+			{ 0,0,0,0,1,1,1,1,2,2,2,2,0,0,0,0 }, { 0,1,2,0,1,2,0,1,2,0,1,2,0,1,2,0 }, { 0,1,2,0,2,0,1,2,1,2,0,1,0,1,2,0 }, { 0,0,1,1,2,2,0,0,1,1,2,2,0,0,1,1 },
+			{ 0,0,1,1,1,1,2,2,2,2,0,0,0,0,1,1 }, { 0,1,0,1,0,1,0,1,2,2,2,2,2,2,2,2 }, { 0,0,0,0,0,0,0,0,2,1,2,1,2,1,2,1 }, { 0,0,2,2,1,1,2,2,0,0,2,2,1,1,2,2 },
+			{ 0,0,2,2,0,0,1,1,0,0,2,2,0,0,1,1 }, { 0,2,2,0,1,2,2,1,0,2,2,0,1,2,2,1 }, { 0,1,0,1,2,2,2,2,2,2,2,2,0,1,0,1 }, { 0,0,0,0,2,1,2,1,2,1,2,1,2,1,2,1 },
+			{ 0,1,0,1,0,1,0,1,0,1,0,1,2,2,2,2 }, { 0,2,2,2,0,1,1,1,0,2,2,2,0,1,1,1 }, { 0,0,0,2,1,1,1,2,0,0,0,2,1,1,1,2 }, { 0,0,0,0,2,1,1,2,2,1,1,2,2,1,1,2 },
+			{ 0,2,2,2,0,1,1,1,0,1,1,1,0,2,2,2 }, { 0,0,0,2,1,1,1,2,1,1,1,2,0,0,0,2 }, { 0,1,1,0,0,1,1,0,0,1,1,0,2,2,2,2 }, { 0,0,0,0,0,0,0,0,2,1,1,2,2,1,1,2 },
+			{ 0,1,1,0,0,1,1,0,2,2,2,2,2,2,2,2 }, { 0,0,2,2,0,0,1,1,0,0,1,1,0,0,2,2 }, { 0,0,2,2,1,1,2,2,1,1,2,2,0,0,2,2 }, { 0,0,0,0,0,0,0,0,0,0,0,0,2,1,1,2 },
+			{ 0,0,0,2,0,0,0,1,0,0,0,2,0,0,0,1 }, { 0,2,2,2,1,2,2,2,0,2,2,2,1,2,2,2 }, { 0,1,0,1,2,2,2,2,2,2,2,2,2,2,2,2 }, { 0,1,1,1,2,0,1,1,2,2,0,1,2,2,2,0 },
+		};
+
+		// Pixels whose index drops its top bit, for the second subset of two, and the second and third of three
+		const uint8_t Bc7Anchors2[64] =
+		{
+			15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+			15, 2, 8, 2, 2, 8, 8, 15, 2, 8, 2, 2, 8, 8, 2, 2,
+			15, 15, 6, 8, 2, 8, 15, 15, 2, 8, 2, 2, 2, 15, 15, 6,
+			6, 2, 6, 8, 15, 15, 2, 2, 15, 15, 15, 15, 15, 2, 2, 15,
+		};
+
+		const uint8_t Bc7Anchors3Second[64] =
+		{
+			3, 3, 15, 15, 8, 3, 15, 15, 8, 8, 6, 6, 6, 5, 3, 3,
+			3, 3, 8, 15, 3, 3, 6, 10, 5, 8, 8, 6, 8, 5, 15, 15,
+			8, 15, 3, 5, 6, 10, 8, 15, 15, 3, 15, 5, 15, 15, 15, 15,
+			3, 15, 5, 5, 5, 8, 5, 10, 5, 10, 8, 13, 15, 12, 3, 3,
+		};
+
+		const uint8_t Bc7Anchors3Third[64] =
+		{
+			15, 8, 8, 3, 15, 15, 3, 8, 15, 15, 15, 15, 15, 15, 15, 8,
+			15, 8, 15, 3, 15, 8, 15, 8, 3, 15, 6, 10, 15, 15, 10, 8,
+			15, 3, 15, 10, 10, 8, 9, 10, 6, 15, 8, 15, 3, 6, 6, 8,
+			15, 3, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 3, 15, 15, 8,
+		};
+
+		const uint8_t Bc7Weights2[4] = { 0, 21, 43, 64 };
+		const uint8_t Bc7Weights3[8] = { 0, 9, 18, 27, 37, 46, 55, 64 };
+		const uint8_t Bc7Weights4[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+		// Reads fields from a block, least significant bit first
+		class BlockReader
+		{
+		public:
+			BlockReader(const uint8_t * block, int position) : m_block(block), m_position(position) {}
+
+			int Read(int bits)
+			{
+				int value = 0;
+				for (int i = 0; i < bits; ++i, ++m_position)
+					value |= ((m_block[m_position >> 3] >> (m_position & 7)) & 1) << i;
+				return value;
+			}
+
+		private:
+			const uint8_t * m_block;
+			int m_position;
+		};
+
+		uint8_t Interpolate(int endpoint0, int endpoint1, int index, int indexBits)
+		{
+			const uint8_t * weights = indexBits == 2 ? Bc7Weights2 : (indexBits == 3 ? Bc7Weights3 : Bc7Weights4);
+			return static_cast<uint8_t>(((64 - weights[index]) * endpoint0 + weights[index] * endpoint1 + 32) >> 6);
+		}
+
+		void DecodeBc7Block(const uint8_t * block, uint8_t * pixels)
+		{
+			// The mode is the position of the lowest set bit.  Blocks without one are reserved, and decode to zero.
+			int modeIndex = 0;
+			while (modeIndex < 8 && !(block[0] & (1 << modeIndex)))
+				++modeIndex;
+			if (modeIndex == 8)
+			{
+				std::memset(pixels, 0, 16 * 4);
+				return;
+			}
+			const Bc7Mode & mode = Bc7Modes[modeIndex];
+			BlockReader reader(block, modeIndex + 1);
+			const int partition = reader.Read(mode.partitionBits);
+			const int rotation = reader.Read(mode.rotationBits);
+			const int indexSelection = reader.Read(mode.indexSelectionBits);
+
+			// Endpoints are stored channel by channel, followed by their P bits
+			const int endpointCount = mode.subsets * 2;
+			int endpoints[6][4];
+			for (int channel = 0; channel < 4; ++channel)
+			{
+				const int bits = channel < 3 ? mode.colorBits : mode.alphaBits;
+				for (int i = 0; i < endpointCount; ++i)
+					endpoints[i][channel] = bits ? reader.Read(bits) : 255;
+			}
+			int pBits[6] = {};
+			if (mode.endpointPBits)
+			{
+				for (int i = 0; i < endpointCount; ++i)
+					pBits[i] = reader.Read(1);
+			}
+			else if (mode.sharedPBits)
+			{
+				for (int i = 0; i < mode.subsets; ++i)
+					pBits[i * 2] = pBits[i * 2 + 1] = reader.Read(1);
+			}
+			const bool hasPBits = mode.endpointPBits || mode.sharedPBits;
+			for (int i = 0; i < endpointCount; ++i)
+			{
+				for (int channel = 0; channel < 4; ++channel)
+				{
+					int bits = channel < 3 ? mode.colorBits : mode.alphaBits;
+					if (!bits)
+						continue;
+					int value = endpoints[i][channel];
+					if (hasPBits)
+					{
+						value = (value << 1) | pBits[i];
+						++bits;
+					}
+					value <<= 8 - bits;
+					endpoints[i][channel] = value | (value >> bits);
+				}
+			}
+
+			// Anchor indices are one bit shorter, with the top bit implied to be zero
+			const uint8_t * subsets = mode.subsets == 2 ? Bc7Partitions2[partition] : (mode.subsets == 3 ? Bc7Partitions3[partition] : nullptr);
+			auto isAnchor = [&] (int pixel)
+			{
+				return pixel == 0 ||
+					(mode.subsets == 2 && pixel == Bc7Anchors2[partition]) ||
+					(mode.subsets == 3 && (pixel == Bc7Anchors3Second[partition] || pixel == Bc7Anchors3Third[partition]));
+			};
+			int indices[16];
+			int secondaryIndices[16] = {};
+			for (int i = 0; i < 16; ++i)
+				indices[i] = reader.Read(isAnchor(i) ? mode.indexBits - 1 : mode.indexBits);
+			if (mode.secondaryIndexBits)
+			{
+				for (int i = 0; i < 16; ++i)
+					secondaryIndices[i] = reader.Read(i == 0 ? mode.secondaryIndexBits - 1 : mode.secondaryIndexBits);
+			}
+
+			for (int i = 0; i < 16; ++i)
+			{
+				const int subset = subsets ? subsets[i] : 0;
+				const int * endpoint0 = endpoints[subset * 2];
+				const int * endpoint1 = endpoints[subset * 2 + 1];
+				int colorIndex = indices[i];
+				int colorBits = mode.indexBits;
+				int alphaIndex = indices[i];
+				int alphaBits = mode.indexBits;
+				if (mode.secondaryIndexBits)
+				{
+					alphaIndex = secondaryIndices[i];
+					alphaBits = mode.secondaryIndexBits;
+					if (indexSelection)
+					{
+						std::swap(colorIndex, alphaIndex);
+						std::swap(colorBits, alphaBits);
+					}
+				}
+				uint8_t * pixel = pixels + i * 4;
+				for (int channel = 0; channel < 3; ++channel)
+					pixel[channel] = Interpolate(endpoint0[channel], endpoint1[channel], colorIndex, colorBits);
+				pixel[3] = Interpolate(endpoint0[3], endpoint1[3], alphaIndex, alphaBits);
+				if (rotation)
+					std::swap(pixel[3], pixel[rotation - 1]);
+			}
+		}
+
+		// Fits endpoints to the block's extremes along its principal axis, then picks the nearest palette color
+		// for each pixel.  The first endpoint is kept above the second, so BC1 blocks stay in four color mode.
+		void EncodeColorBlock(const uint8_t * pixels, uint8_t * block)
+		{
+			float mean[3] = {};
+			for (int i = 0; i < 16; ++i)
+			{
+				for (int channel = 0; channel < 3; ++channel)
+					mean[channel] += pixels[i * 4 + channel] / 16.0f;
+			}
+			float covariance[3][3] = {};
+			for (int i = 0; i < 16; ++i)
+			{
+				for (int a = 0; a < 3; ++a)
+				{
+					for (int b = 0; b < 3; ++b)
+						covariance[a][b] += (pixels[i * 4 + a] - mean[a]) * (pixels[i * 4 + b] - mean[b]);
+				}
+			}
+			float axis[3] = { 1.0f, 1.0f, 1.0f };
+			for (int iteration = 0; iteration < 8; ++iteration)
+			{
+				float next[3] = {};
+				for (int a = 0; a < 3; ++a)
+				{
+					for (int b = 0; b < 3; ++b)
+						next[a] += covariance[a][b] * axis[b];
+				}
+				const float length = std::max({ std::fabs(next[0]), std::fabs(next[1]), std::fabs(next[2]) });
+				if (length == 0.0f)
+					break;
+				for (int a = 0; a < 3; ++a)
+					axis[a] = next[a] / length;
+			}
+			int minPixel = 0;
+			int maxPixel = 0;
+			float minProjection = 0.0f;
+			float maxProjection = 0.0f;
+			for (int i = 0; i < 16; ++i)
+			{
+				const float projection = pixels[i * 4 + 0] * axis[0] + pixels[i * 4 + 1] * axis[1] + pixels[i * 4 + 2] * axis[2];
+				if (i == 0 || projection < minProjection)
+				{
+					minProjection = projection;
+					minPixel = i;
+				}
+				if (i == 0 || projection > maxProjection)
+				{
+					maxProjection = projection;
+					maxPixel = i;
+				}
+			}
+			uint16_t color0 = Pack565(pixels + maxPixel * 4);
+			uint16_t color1 = Pack565(pixels + minPixel * 4);
+			if (color0 < color1)
+				std::swap(color0, color1);
+			block[0] = static_cast<uint8_t>(color0);
+			block[1] = static_cast<uint8_t>(color0 >> 8);
+			block[2] = static_cast<uint8_t>(color1);
+			block[3] = static_cast<uint8_t>(color1 >> 8);
+
+			Color palette[4];
+			GetColorPalette(block, false, palette);
+			uint32_t indices = 0;
+			for (int i = 0; color0 != color1 && i < 16; ++i)
+			{
+				const uint8_t * pixel = pixels + i * 4;
+				int best = 0;
+				int bestDistance = INT_MAX;
+				for (int entry = 0; entry < 4; ++entry)
+				{
+					const int r = pixel[0] - palette[entry].r;
+					const int g = pixel[1] - palette[entry].g;
+					const int b = pixel[2] - palette[entry].b;
+					const int distance = r * r + g * g + b * b;
+					if (distance < bestDistance)
+					{
+						best = entry;
+						bestDistance = distance;
+					}
+				}
+				indices |= static_cast<uint32_t>(best) << (i * 2);
+			}
+			for (int i = 0; i < 4; ++i)
+				block[4 + i] = static_cast<uint8_t>(indices >> (i * 8));
+		}
+
+		// Uses the eight value mode between the block's alpha extremes
+		void EncodeAlphaBlock(const uint8_t * pixels, uint8_t * block)
+		{
+			uint8_t minAlpha = 255;
+			uint8_t maxAlpha = 0;
+			for (int i = 0; i < 16; ++i)
+			{
+				minAlpha = std::min(minAlpha, pixels[i * 4 + 3]);
+				maxAlpha = std::max(maxAlpha, pixels[i * 4 + 3]);
+			}
+			block[0] = maxAlpha;
+			block[1] = minAlpha;
+			uint8_t palette[8];
+			GetAlphaPalette(block, palette);
+			uint64_t indices = 0;
+			for (int i = 0; maxAlpha != minAlpha && i < 16; ++i)
+			{
+				int best = 0;
+				for (int entry = 1; entry < 8; ++entry)
+				{
+					if (std::abs(pixels[i * 4 + 3] - palette[entry]) < std::abs(pixels[i * 4 + 3] - palette[best]))
+						best = entry;
+				}
+				indices |= static_cast<uint64_t>(best) << (i * 3);
+			}
+			for (int i = 0; i < 6; ++i)
+				block[2 + i] = static_cast<uint8_t>(indices >> (i * 8));
+		}
+
+	}
+
+	size_t GetCompressedSize(BlockFormat format, int width, int height)
+	{
+		return static_cast<size_t>((width + 3) / 4) * ((height + 3) / 4) * GetBlockSize(format);
+	}
+
+	std::optional<CompressedImage> LoadCompressedImage(const char * filename)
+	{
+		std::ifstream stream(filename, std::ios::binary);
+		if (!stream)
+			return std::optional<CompressedImage>();
+		std::vector<uint8_t> file((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+		if (file.size() >= 4 && ReadUInt32(file, 0) == DdsMagic)
+			return ReadDds(file);
+		return ReadKtx(file);
+	}
+
+	bool SaveCompressedImage(const char * filename, const CompressedImage & image)
+	{
+		if (image.levels.empty())
+			return false;
+
+		// Flags mark caps, height, width, pixel format, mip count and linear size as valid
+		const bool dx10 = image.format == BlockFormat::BC7;
+		std::vector<uint8_t> file(DdsHeaderSize + (dx10 ? DdsDx10HeaderSize : 0));
+		WriteUInt32(file, 0, DdsMagic);
+		WriteUInt32(file, 4, 124);
+		WriteUInt32(file, DdsFlagsOffset, 0x000A1007);
+		WriteUInt32(file, DdsHeightOffset, static_cast<uint32_t>(image.levels.front().height));
+		WriteUInt32(file, DdsWidthOffset, static_cast<uint32_t>(image.levels.front().width));
+		WriteUInt32(file, 20, static_cast<uint32_t>(image.levels.front().data.size()));
+		WriteUInt32(file, DdsMipCountOffset, static_cast<uint32_t>(image.levels.size()));
+		WriteUInt32(file, 76, 32);
+		WriteUInt32(file, 80, 0x4);
+		const uint32_t fourCC[] = { MakeFourCC('D', 'X', 'T', '1'), MakeFourCC('D', 'X', 'T', '5'), MakeFourCC('D', 'X', '1', '0') };
+		WriteUInt32(file, DdsFourCCOffset, fourCC[static_cast<int>(image.format)]);
+		WriteUInt32(file, 108, image.levels.size() > 1 ? 0x401008 : 0x1000);
+		if (dx10)
+		{
+			WriteUInt32(file, DdsDx10FormatOffset, DxgiBC7);
+			WriteUInt32(file, DdsDx10FormatOffset + 4, 3);
+			WriteUInt32(file, DdsDx10FormatOffset + 12, 1);
+		}
+		for (const auto & level : image.levels)
+			file.insert(file.end(), level.data.begin(), level.data.end());
+
+		std::ofstream stream(filename, std::ios::binary);
+		stream.write(reinterpret_cast<const char *>(file.data()), static_cast<std::streamsize>(file.size()));
+		return static_cast<bool>(stream);
+	}
+
+	void DecodeBlocks(BlockFormat format, const uint8_t * blocks, int width, int height, uint8_t * pixels)
+	{
+		const size_t blockSize = GetBlockSize(format);
+		uint8_t decoded[16 * 4];
+		for (int blockY = 0; blockY < height; blockY += 4)
+		{
+			for (int blockX = 0; blockX < width; blockX += 4, blocks += blockSize)
+			{
+				if (format == BlockFormat::BC1)
+					DecodeColorBlock(blocks, true, decoded);
+				else if (format == BlockFormat::BC3)
+				{
+					DecodeColorBlock(blocks + 8, false, decoded);
+					DecodeAlphaBlock(blocks, decoded);
+				}
+				else
+					DecodeBc7Block(blocks, decoded);
+
+				// Blocks overhanging the right or bottom edge are cropped
+				const int columns = std::min(4, width - blockX);
+				const int rows = std::min(4, height - blockY);
+				for (int y = 0; y < rows; ++y)
+					std::memcpy(pixels + ((static_cast<size_t>(blockY) + y) * width + blockX) * 4, decoded + y * 16, columns * 4);
+			}
+		}
+	}
+
+	std::vector<uint8_t> EncodeBlocks(BlockFormat format, const uint8_t * pixels, int width, int height)
+	{
+		if (format == BlockFormat::BC7)
+			return std::vector<uint8_t>();
+		std::vector<uint8_t> blocks(GetCompressedSize(format, width, height));
+		uint8_t * block = blocks.data();
+		uint8_t source[16 * 4];
+		for (int blockY = 0; blockY < height; blockY += 4)
+		{
+			for (int blockX = 0; blockX < width; blockX += 4)
+			{
+				// Blocks overhanging the right or bottom edge repeat the edge pixels
+				for (int y = 0; y < 4; ++y)
+				{
+					for (int x = 0; x < 4; ++x)
+					{
+						const int sourceX = std::min(blockX + x, width - 1);
+						const int sourceY = std::min(blockY + y, height - 1);
+						std::memcpy(source + (y * 4 + x) * 4, pixels + (static_cast<size_t>(sourceY) * width + sourceX) * 4, 4);
+					}
+				}
+				if (format == BlockFormat::BC3)
+				{
+					EncodeAlphaBlock(source, block);
+					block += 8;
+				}
+				EncodeColorBlock(source, block);
+				block += 8;
+			}
+		}
+		return blocks;
+	}
+
+}
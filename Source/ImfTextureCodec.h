@@ -0,0 +1,74 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2021 James Boer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+// Block compression codec and DDS / KTX container support.  This has no OpenGL or ImGui dependencies, so the
+// TextureConverter tool builds it on its own.
+
+namespace ImFrame
+{
+
+	// Each 4x4 pixel block takes 8 bytes in BC1, and 16 bytes in BC3 and BC7
+	enum class BlockFormat
+	{
+		BC1,
+		BC3,
+		BC7,
+	};
+
+	struct CompressedLevel
+	{
+		int width = 0;
+		int height = 0;
+		std::vector<uint8_t> data;
+	};
+
+	// Base level first, followed by any mip levels stored in the file
+	struct CompressedImage
+	{
+		BlockFormat format = BlockFormat::BC1;
+		std::vector<CompressedLevel> levels;
+	};
+
+	size_t GetCompressedSize(BlockFormat format, int width, int height);
+
+	// Reads DDS or KTX files, detected from their contents
+	std::optional<CompressedImage> LoadCompressedImage(const char * filename);
+
+	// Writes a DDS file.  BC7 uses the DX10 header extension.
+	bool SaveCompressedImage(const char * filename, const CompressedImage & image);
+
+	// Decodes blocks into width * height RGBA pixels
+	void DecodeBlocks(BlockFormat format, const uint8_t * blocks, int width, int height, uint8_t * pixels);
+
+	// Encodes width * height RGBA pixels as BC1 or BC3 blocks.  BC7 encoding isn't supported.
+	std::vector<uint8_t> EncodeBlocks(BlockFormat format, const uint8_t * pixels, int width, int height);
+
+}
@@ -0,0 +1,730 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2021 James Boer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include "ImfInternal.h"
+
+namespace ImFrame
+{
+
+	// Cache entry shared by all handles to one texture.  The texture is null while evicted.
+	struct CachedTexture
+	{
+		~CachedTexture();
+		std::string key;
+		std::string filename;
+		TextureOptions options;
+		AsyncTexturePtr texture;
+		uint64_t lastUsedFrame = 0;
+	};
+
+	namespace
+	{
+
+		// Bytes of pixel data uploaded to the GPU per frame by default
+		const size_t DefaultUploadBudget = 8 * 1024 * 1024;
+
+		// Estimated GPU memory used by cached textures before eviction starts, by default
+		const size_t DefaultCacheBudget = 512 * 1024 * 1024;
+
+		// Image decoded by a worker thread, uploaded to the GPU in rows over one or more frames, one mip
+		// level after another
+		struct PendingUpload
+		{
+			std::weak_ptr<AsyncTexture> texture;
+			std::optional<ImageInfo> image;
+			TextureOptions options;
+			std::vector<ImageData> mips;
+			GLuint textureID = 0;
+			int level = 0;
+			int uploadedRows = 0;
+		};
+
+		// Rows of one mip level uploaded this frame.  Offset is into this frame's staging data.
+		struct UploadPiece
+		{
+			GLuint textureID;
+			int level;
+			int firstRow;
+			int width;
+			int rows;
+			const uint8_t * source;
+			size_t offset;
+			size_t size;
+		};
+
+		// Pixel buffer objects cycle through frames, so the GPU can read one while we fill the next
+		const int PixelBufferCount = 3;
+		struct PixelBuffer
+		{
+			GLuint buffer = 0;
+			size_t size = 0;
+			GLsync fence = nullptr;
+		};
+
+		struct TextureData
+		{
+			std::mutex decodedMutex;
+			std::deque<PendingUpload> decoded;
+			std::deque<PendingUpload> uploads;
+			size_t uploadBudget = DefaultUploadBudget;
+			GLuint placeholderTexture = 0;
+			PixelBuffer pixelBuffers[PixelBufferCount];
+			int pixelBufferIndex = 0;
+			std::unordered_map<std::string, std::weak_ptr<CachedTexture>> cache;
+			size_t cacheBudget = DefaultCacheBudget;
+			size_t cacheSize = 0;
+			uint64_t frame = 0;
+		};
+
+		std::unique_ptr<TextureData> s_textureData;
+
+		TextureData & GetTextureData()
+		{
+			if (!s_textureData)
+				s_textureData = std::make_unique<TextureData>();
+			return *s_textureData;
+		}
+
+		int GetMipLevelCount(int width, int height, const TextureOptions & options)
+		{
+			if (options.mipmaps == MipmapMode::None)
+				return 1;
+			int levels = 1;
+			while (width > 1 || height > 1)
+			{
+				width = std::max(1, width / 2);
+				height = std::max(1, height / 2);
+				++levels;
+			}
+			return levels;
+		}
+
+		// Builds every level below the image, each downsampled from the one above.  Resampling is gamma
+		// correct and alpha weighted.
+		std::vector<ImageData> GenerateMipmaps(const ImageInfo & image)
+		{
+			std::vector<ImageData> mips;
+			const uint8_t * source = image.data.data();
+			int width = image.width;
+			int height = image.height;
+			while (width > 1 || height > 1)
+			{
+				const int mipWidth = std::max(1, width / 2);
+				const int mipHeight = std::max(1, height / 2);
+				ImageData mip(static_cast<size_t>(mipWidth) * mipHeight * image.channels);
+				stbir_resize_uint8_srgb(source, width, height, 0, mip.data(), mipWidth, mipHeight, 0, image.channels, 3, 0);
+				source = mip.data();
+				width = mipWidth;
+				height = mipHeight;
+				mips.push_back(std::move(mip));
+			}
+			return mips;
+		}
+
+		void ApplyTextureOptions(const TextureOptions & options, int levels)
+		{
+			const GLint wrapModes[] = { GL_CLAMP_TO_EDGE, GL_REPEAT, GL_MIRRORED_REPEAT };
+			GLint minFilter = options.linearFilter ? GL_LINEAR : GL_NEAREST;
+			if (options.mipmaps != MipmapMode::None)
+				minFilter = options.linearFilter ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST_MIPMAP_NEAREST;
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, minFilter);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, options.linearFilter ? GL_LINEAR : GL_NEAREST);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, wrapModes[static_cast<int>(options.wrapS)]);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, wrapModes[static_cast<int>(options.wrapT)]);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levels - 1);
+			if (options.anisotropy > 1.0f && (GLAD_GL_EXT_texture_filter_anisotropic || GLAD_GL_ARB_texture_filter_anisotropic))
+			{
+				GLfloat maxAnisotropy = 1.0f;
+				glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT, &maxAnisotropy);
+				glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY_EXT, std::min(options.anisotropy, maxAnisotropy));
+			}
+		}
+
+		// Creates and binds a texture, allocating every level the options call for.  Level zero is filled
+		// from the pixels if given, while other levels are left for the caller to upload or generate.
+		GLuint CreateTexture(int width, int height, const void * pixels, const TextureOptions & options)
+		{
+			// Create a OpenGL texture identifier
+			GLuint texture;
+			glGenTextures(1, &texture);
+			glBindTexture(GL_TEXTURE_2D, texture);
+
+			// Setup filtering parameters for display
+			const int levels = GetMipLevelCount(width, height, options);
+			ApplyTextureOptions(options, levels);
+
+			// Upload pixels into texture, or just allocate storage if there are none yet
+#if defined(GL_UNPACK_ROW_LENGTH) && !defined(__EMSCRIPTEN__)
+			glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+#endif
+			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+			if (options.mipmaps == MipmapMode::Cpu)
+			{
+				for (int level = 1; level < levels; ++level)
+					glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA, std::max(1, width >> level), std::max(1, height >> level), 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+			}
+
+			// Texture binding has changed behind ImGui's back
+			ImGui_ImplOpenGL3_InvalidateStateCache();
+
+			return texture;
+		}
+
+		GLuint GetPlaceholderTexture()
+		{
+			auto & data = GetTextureData();
+			if (!data.placeholderTexture)
+			{
+				const uint8_t pixel[4] = { 64, 64, 64, 255 };
+				data.placeholderTexture = CreateTexture(1, 1, pixel, TextureOptions());
+			}
+			return data.placeholderTexture;
+		}
+
+		std::string GetCacheKey(const char * filename, const TextureOptions & options)
+		{
+			std::string key = filename;
+			key += '|' + std::to_string(static_cast<int>(options.mipmaps));
+			key += '|' + std::to_string(options.anisotropy);
+			key += '|' + std::to_string(static_cast<int>(options.wrapS));
+			key += '|' + std::to_string(static_cast<int>(options.wrapT));
+			key += '|' + std::to_string(options.linearFilter);
+			return key;
+		}
+
+		bool IsPixelBufferSupported()
+		{
+			// Pixel buffers are core since 2.1, but reusing them safely requires fences
+			return GLAD_GL_ARB_sync || (GLVersion.major * 10 + GLVersion.minor) >= 32;
+		}
+
+		// Binds the next pixel buffer with room for at least the given size.  Returns null if the GPU is still
+		// reading from it, in which case uploads wait for a later frame rather than stalling.
+		PixelBuffer * AcquirePixelBuffer(size_t size)
+		{
+			auto & data = *s_textureData;
+			auto & pixelBuffer = data.pixelBuffers[data.pixelBufferIndex];
+			if (pixelBuffer.fence)
+			{
+				if (glClientWaitSync(pixelBuffer.fence, 0, 0) == GL_TIMEOUT_EXPIRED)
+					return nullptr;
+				glDeleteSync(pixelBuffer.fence);
+				pixelBuffer.fence = nullptr;
+			}
+			if (!pixelBuffer.buffer)
+				glGenBuffers(1, &pixelBuffer.buffer);
+			glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pixelBuffer.buffer);
+			if (pixelBuffer.size < size)
+			{
+				glBufferData(GL_PIXEL_UNPACK_BUFFER, static_cast<GLsizeiptr>(size), nullptr, GL_STREAM_DRAW);
+				pixelBuffer.size = size;
+			}
+			data.pixelBufferIndex = (data.pixelBufferIndex + 1) % PixelBufferCount;
+			return &pixelBuffer;
+		}
+
+		// A full mip chain adds a third to the size of the base level
+		size_t GetTextureSize(const TextureInfo & texture, const TextureOptions & options)
+		{
+			const size_t size = static_cast<size_t>(texture.width) * texture.height * 4;
+			return options.mipmaps == MipmapMode::None ? size : size + size / 3;
+		}
+
+		// Totals the memory used by loaded cache entries, then evicts the least recently drawn until back under
+		// budget.  Textures drawn in the last frame are never evicted, since they're likely still on screen.
+		void UpdateTextureCache()
+		{
+			auto & data = *s_textureData;
+			std::vector<CachedTexture *> loaded;
+			data.cacheSize = 0;
+			for (auto & entry : data.cache)
+			{
+				auto cached = entry.second.lock();
+				if (!cached || !cached->texture || cached->texture->state != LoadState::Complete)
+					continue;
+				data.cacheSize += GetTextureSize(cached->texture->texture, cached->options);
+				loaded.push_back(cached.get());
+			}
+			if (data.cacheSize <= data.cacheBudget)
+				return;
+			std::sort(loaded.begin(), loaded.end(), [] (const CachedTexture * a, const CachedTexture * b)
+			{
+				return a->lastUsedFrame < b->lastUsedFrame;
+			});
+			for (auto cached : loaded)
+			{
+				if (data.cacheSize <= data.cacheBudget || cached->lastUsedFrame + 1 >= data.frame)
+					break;
+				data.cacheSize -= GetTextureSize(cached->texture->texture, cached->options);
+				cached->texture.reset();
+			}
+		}
+
+		// Splits pending uploads into whole rows of each mip level, in order, until the budget is spent, and
+		// advances their progress.  The first piece always gets at least one row, so images with very wide rows
+		// still make progress.
+		std::vector<UploadPiece> PlanUploads(std::deque<PendingUpload> & uploads, size_t budget)
+		{
+			std::vector<UploadPiece> pieces;
+			size_t planned = 0;
+			for (auto & upload : uploads)
+			{
+				if (planned >= budget)
+					break;
+				const ImageInfo & image = upload.image.value();
+
+				// Allocate texture storage before any pixel buffer is bound, or the null data would be read from it
+				if (!upload.textureID)
+					upload.textureID = CreateTexture(image.width, image.height, nullptr, upload.options);
+
+				const int levels = 1 + static_cast<int>(upload.mips.size());
+				while (upload.level < levels && planned < budget)
+				{
+					const int width = std::max(1, image.width >> upload.level);
+					const int height = std::max(1, image.height >> upload.level);
+					const uint8_t * source = upload.level == 0 ? image.data.data() : upload.mips[upload.level - 1].data();
+					const size_t rowSize = static_cast<size_t>(width) * image.channels;
+					int rows = static_cast<int>(std::min<size_t>((budget - planned) / rowSize, height - upload.uploadedRows));
+					if (rows == 0 && pieces.empty())
+						rows = 1;
+					if (rows == 0)
+						return pieces;
+					pieces.push_back({ upload.textureID, upload.level, upload.uploadedRows, width, rows,
+						source + rowSize * upload.uploadedRows, planned, rowSize * rows });
+					planned += rowSize * rows;
+					upload.uploadedRows += rows;
+					if (upload.uploadedRows == height)
+					{
+						++upload.level;
+						upload.uploadedRows = 0;
+					}
+				}
+				if (upload.level < levels)
+					break;
+			}
+			return pieces;
+		}
+
+		bool IsUploadComplete(const PendingUpload & upload)
+		{
+			return upload.level > static_cast<int>(upload.mips.size());
+		}
+
+		bool IsBlockFormatSupported(BlockFormat format)
+		{
+			// BPTC is core since 4.2
+			if (format == BlockFormat::BC7)
+				return GLAD_GL_ARB_texture_compression_bptc || (GLVersion.major * 10 + GLVersion.minor) >= 42;
+			return GLAD_GL_EXT_texture_compression_s3tc;
+		}
+
+		GLenum GetBlockInternalFormat(BlockFormat format)
+		{
+			switch (format)
+			{
+				case BlockFormat::BC1: return GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+				case BlockFormat::BC3: return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+				default: return GL_COMPRESSED_RGBA_BPTC_UNORM_ARB;
+			}
+		}
+
+	}
+
+	void UpdateTextures()
+	{
+		if (!s_textureData)
+			return;
+		auto & data = *s_textureData;
+		++data.frame;
+		UpdateTextureCache();
+
+		// Collect images decoded since the last frame
+		{
+			std::lock_guard<std::mutex> lock(data.decodedMutex);
+			while (!data.decoded.empty())
+			{
+				auto & upload = data.decoded.front();
+				if (auto texture = upload.texture.lock())
+				{
+					if (upload.image)
+					{
+						texture->texture.width = upload.image->width;
+						texture->texture.height = upload.image->height;
+						data.uploads.push_back(std::move(upload));
+					}
+					else
+						texture->state = LoadState::Failed;
+				}
+				data.decoded.pop_front();
+			}
+		}
+
+		// Drop uploads whose handles have been released
+		auto released = std::remove_if(data.uploads.begin(), data.uploads.end(), [] (PendingUpload & upload)
+		{
+			if (!upload.texture.expired())
+				return false;
+			if (upload.textureID)
+				glDeleteTextures(1, &upload.textureID);
+			return true;
+		});
+		data.uploads.erase(released, data.uploads.end());
+		if (data.uploads.empty())
+			return;
+
+		// Keep frames coming while uploads remain, even in power saving mode
+		RequestRedraw();
+
+		// A budget of zero means no limit
+		const size_t budget = data.uploadBudget ? data.uploadBudget : std::numeric_limits<size_t>::max();
+		auto pieces = PlanUploads(data.uploads, budget);
+		const size_t stagingSize = pieces.back().offset + pieces.back().size;
+
+		// Stage pixels in a pixel buffer where possible, so the transfer into textures doesn't block on client
+		// memory.  If the GPU is still reading the next buffer, transfer directly this frame rather than stall.
+		PixelBuffer * pixelBuffer = IsPixelBufferSupported() ? AcquirePixelBuffer(stagingSize) : nullptr;
+		if (pixelBuffer)
+		{
+			auto staging = static_cast<uint8_t *>(glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, static_cast<GLsizeiptr>(stagingSize),
+				GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT));
+			if (staging)
+			{
+				for (const auto & piece : pieces)
+					std::memcpy(staging + piece.offset, piece.source, piece.size);
+				glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+			}
+			else
+			{
+				glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+				pixelBuffer = nullptr;
+			}
+		}
+
+		// Transfer rows into textures, either from the pixel buffer or straight from the decoded image
+		for (const auto & piece : pieces)
+		{
+			const void * pixels = pixelBuffer ?
+				reinterpret_cast<const void *>(static_cast<intptr_t>(piece.offset)) :
+				static_cast<const void *>(piece.source);
+			glBindTexture(GL_TEXTURE_2D, piece.textureID);
+			glTexSubImage2D(GL_TEXTURE_2D, piece.level, 0, piece.firstRow, piece.width, piece.rows, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+		}
+		if (pixelBuffer)
+		{
+			pixelBuffer->fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+			glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+		}
+
+		// Hand completed textures over to their handles
+		while (!data.uploads.empty() && IsUploadComplete(data.uploads.front()))
+		{
+			auto & upload = data.uploads.front();
+			if (upload.options.mipmaps == MipmapMode::Gpu)
+			{
+				glBindTexture(GL_TEXTURE_2D, upload.textureID);
+				glGenerateMipmap(GL_TEXTURE_2D);
+			}
+			auto texture = upload.texture.lock();
+			texture->texture.textureID = upload.textureID;
+			texture->state = LoadState::Complete;
+			data.uploads.pop_front();
+		}
+		ImGui_ImplOpenGL3_InvalidateStateCache();
+	}
+
+	void ShutDownTextures()
+	{
+		if (!s_textureData)
+			return;
+
+		for (auto & upload : s_textureData->uploads)
+		{
+			if (upload.textureID)
+				glDeleteTextures(1, &upload.textureID);
+		}
+		for (auto & pixelBuffer : s_textureData->pixelBuffers)
+		{
+			if (pixelBuffer.fence)
+				glDeleteSync(pixelBuffer.fence);
+			if (pixelBuffer.buffer)
+				glDeleteBuffers(1, &pixelBuffer.buffer);
+		}
+		if (s_textureData->placeholderTexture)
+			glDeleteTextures(1, &s_textureData->placeholderTexture);
+		s_textureData.reset();
+	}
+
+	AsyncTexture::~AsyncTexture()
+	{
+		if (state == LoadState::Complete)
+			glDeleteTextures(1, &texture.textureID);
+	}
+
+	CachedTexture::~CachedTexture()
+	{
+		if (s_textureData)
+			s_textureData->cache.erase(key);
+	}
+
+	ImageData::ImageData(uint8_t * data, size_t size, Deleter deleter) :
+		m_data(data),
+		m_size(size),
+		m_deleter(deleter)
+	{
+	}
+
+	ImageData::ImageData(size_t size) :
+		m_data(new uint8_t[size]),
+		m_size(size),
+		m_deleter([] (void * data) { delete [] static_cast<uint8_t *>(data); })
+	{
+	}
+
+	ImageData::ImageData(ImageData && other) noexcept :
+		m_data(std::exchange(other.m_data, nullptr)),
+		m_size(std::exchange(other.m_size, 0)),
+		m_deleter(std::exchange(other.m_deleter, nullptr))
+	{
+	}
+
+	ImageData & ImageData::operator = (ImageData && other) noexcept
+	{
+		if (this != &other)
+		{
+			Release();
+			m_data = std::exchange(other.m_data, nullptr);
+			m_size = std::exchange(other.m_size, 0);
+			m_deleter = std::exchange(other.m_deleter, nullptr);
+		}
+		return *this;
+	}
+
+	ImageData::~ImageData()
+	{
+		Release();
+	}
+
+	void ImageData::Release()
+	{
+		if (m_data && m_deleter)
+			m_deleter(m_data);
+		m_data = nullptr;
+		m_size = 0;
+		m_deleter = nullptr;
+	}
+
+	// Simple helper function to load an image from disk.  The decoded buffer is adopted as-is.
+	std::optional<ImageInfo> LoadImage(const char * filename)
+	{
+		ImageInfo image;
+		unsigned char * pixels = stbi_load(filename, &image.width, &image.height, NULL, 4);
+		if (pixels == NULL)
+			return std::optional<ImageInfo>();
+		image.channels = 4;
+		const size_t size = static_cast<size_t>(image.width) * image.height * image.channels;
+		image.data = ImageData(reinterpret_cast<uint8_t *>(pixels), size, stbi_image_free);
+		return image;
+	}
+
+	// Load an image into caller-provided memory, sized using GetImageInfo().  The image data refers to the
+	// buffer rather than owning it, and is decoded straight into it, so the image is never held twice.  Fails if
+	// the buffer is too small.
+	std::optional<ImageInfo> LoadImage(const char * filename, uint8_t * buffer, size_t bufferSize)
+	{
+		ImageInfo image;
+		if (!stbi_load_into(filename, buffer, bufferSize, &image.width, &image.height, 4))
+			return std::optional<ImageInfo>();
+		image.channels = 4;
+		image.data = ImageData(buffer, static_cast<size_t>(image.width) * image.height * image.channels);
+		return image;
+	}
+
+	// Read image dimensions from the file header without decoding.  Channels are reported as loaded by
+	// LoadImage() (always RGBA), so width * height * channels is the required buffer size.
+	std::optional<ImageInfo> GetImageInfo(const char * filename)
+	{
+		ImageInfo image;
+		int fileChannels = 0;
+		if (!stbi_info(filename, &image.width, &image.height, &fileChannels))
+			return std::optional<ImageInfo>();
+		image.channels = 4;
+		return image;
+	}
+
+	// Simple helper function to load an image from disk into a OpenGL texture
+	std::optional<TextureInfo> LoadTexture(const char * filename, const TextureOptions & options)
+	{
+		auto image = LoadImage(filename);
+		if (!image)
+			return std::optional<TextureInfo>();
+		return LoadTexture(image.value(), options);
+	}
+
+	// Simple helper function to load an image into a OpenGL texture
+	std::optional<TextureInfo> LoadTexture(const ImageInfo& image, const TextureOptions & options)
+	{
+		GLuint image_texture = CreateTexture(image.width, image.height, static_cast<const void *>(image.data.data()), options);
+		if (options.mipmaps == MipmapMode::Cpu)
+		{
+			auto mips = GenerateMipmaps(image);
+			for (size_t i = 0; i < mips.size(); ++i)
+			{
+				const int level = static_cast<int>(i) + 1;
+				glTexSubImage2D(GL_TEXTURE_2D, level, 0, 0, std::max(1, image.width >> level), std::max(1, image.height >> level),
+					GL_RGBA, GL_UNSIGNED_BYTE, static_cast<const void *>(mips[i].data()));
+			}
+		}
+		else if (options.mipmaps == MipmapMode::Gpu)
+			glGenerateMipmap(GL_TEXTURE_2D);
+		return TextureInfo{ image_texture, image.width, image.height };
+	}
+
+	// Load a DDS or KTX file, keeping its blocks compressed in GPU memory if the driver supports the format.
+	// Mip levels come from the file rather than being generated.
+	std::optional<TextureInfo> LoadCompressedTexture(const char * filename, const TextureOptions & options)
+	{
+		auto image = LoadCompressedImage(filename);
+		if (!image)
+			return std::optional<TextureInfo>();
+		const int levels = options.mipmaps == MipmapMode::None ? 1 : static_cast<int>(image->levels.size());
+		TextureOptions levelOptions = options;
+		if (levels == 1)
+			levelOptions.mipmaps = MipmapMode::None;
+
+		GLuint texture;
+		glGenTextures(1, &texture);
+		glBindTexture(GL_TEXTURE_2D, texture);
+		ApplyTextureOptions(levelOptions, levels);
+#if defined(GL_UNPACK_ROW_LENGTH) && !defined(__EMSCRIPTEN__)
+		glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+#endif
+
+		// Fall back to decoding each level to RGBA on the CPU
+		const bool supported = IsBlockFormatSupported(image->format);
+		std::vector<uint8_t> pixels;
+		for (int level = 0; level < levels; ++level)
+		{
+			const auto & compressedLevel = image->levels[level];
+			if (supported)
+			{
+				glCompressedTexImage2D(GL_TEXTURE_2D, level, GetBlockInternalFormat(image->format), compressedLevel.width, compressedLevel.height, 0,
+					static_cast<GLsizei>(compressedLevel.data.size()), compressedLevel.data.data());
+			}
+			else
+			{
+				pixels.resize(static_cast<size_t>(compressedLevel.width) * compressedLevel.height * 4);
+				DecodeBlocks(image->format, compressedLevel.data.data(), compressedLevel.width, compressedLevel.height, pixels.data());
+				glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA, compressedLevel.width, compressedLevel.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+			}
+		}
+		ImGui_ImplOpenGL3_InvalidateStateCache();
+		return TextureInfo{ texture, image->levels.front().width, image->levels.front().height };
+	}
+
+	// Decodes the image on a worker thread, along with any CPU mipmaps, then uploads it from the main loop
+	AsyncTexturePtr LoadTextureAsync(const char * filename, const TextureOptions & options)
+	{
+		auto texture = std::make_shared<AsyncTexture>();
+		texture->texture.textureID = GetPlaceholderTexture();
+		std::weak_ptr<AsyncTexture> weakTexture = texture;
+		GetThreadPool().Enqueue([weakTexture, path = std::string(filename), options] ()
+		{
+			// Skip decoding if the handle was released while still queued
+			if (weakTexture.expired())
+				return;
+			PendingUpload upload;
+			upload.texture = weakTexture;
+			upload.options = options;
+			upload.image = LoadImage(path.c_str());
+			if (upload.image && options.mipmaps == MipmapMode::Cpu)
+				upload.mips = GenerateMipmaps(upload.image.value());
+			{
+				std::lock_guard<std::mutex> lock(s_textureData->decodedMutex);
+				s_textureData->decoded.push_back(std::move(upload));
+			}
+			RequestRedraw();
+		});
+		return texture;
+	}
+
+	CachedTexturePtr LoadCachedTexture(const char * filename, const TextureOptions & options)
+	{
+		auto & data = GetTextureData();
+		std::string key = GetCacheKey(filename, options);
+		auto & entry = data.cache[key];
+		auto cached = entry.lock();
+		if (!cached)
+		{
+			cached = std::make_shared<CachedTexture>();
+			cached->key = std::move(key);
+			cached->filename = filename;
+			cached->options = options;
+			cached->texture = LoadTextureAsync(filename, options);
+			cached->lastUsedFrame = data.frame;
+			entry = cached;
+		}
+		return cached;
+	}
+
+	TextureInfo UseCachedTexture(const CachedTexturePtr & texture)
+	{
+		assert(texture);
+		texture->lastUsedFrame = GetTextureData().frame;
+		if (!texture->texture)
+			texture->texture = LoadTextureAsync(texture->filename.c_str(), texture->options);
+		return texture->texture->texture;
+	}
+
+	LoadState GetCachedTextureState(const CachedTexturePtr & texture)
+	{
+		assert(texture);
+		return texture->texture ? texture->texture->state : LoadState::Pending;
+	}
+
+	size_t GetTextureCacheBudget()
+	{
+		return GetTextureData().cacheBudget;
+	}
+
+	void SetTextureCacheBudget(size_t bytes)
+	{
+		GetTextureData().cacheBudget = bytes;
+	}
+
+	size_t GetTextureCacheSize()
+	{
+		return GetTextureData().cacheSize;
+	}
+
+	size_t GetTextureUploadBudget()
+	{
+		return GetTextureData().uploadBudget;
+	}
+
+	void SetTextureUploadBudget(size_t bytesPerFrame)
+	{
+		GetTextureData().uploadBudget = bytesPerFrame;
+	}
+
+}
@@ -0,0 +1,115 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2021 James Boer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include "ImfInternal.h"
+
+namespace ImFrame
+{
+	namespace
+	{
+		std::unique_ptr<ThreadPool> s_threadPool;
+	}
+
+	ThreadPool::ThreadPool(size_t threadCount)
+	{
+		// By default, leave one hardware thread for the main loop
+		if (threadCount == 0)
+		{
+			const size_t hardwareThreads = std::thread::hardware_concurrency();
+			threadCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+		}
+		m_threads.reserve(threadCount + 1);
+		for (size_t i = 0; i < threadCount; ++i)
+			m_threads.emplace_back([this] { WorkerThread(false); });
+		m_threads.emplace_back([this] { WorkerThread(true); });
+	}
+
+	ThreadPool::~ThreadPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_stopping = true;
+			m_tasks.clear();
+			m_priorityTasks.clear();
+		}
+		m_condition.notify_all();
+		m_priorityCondition.notify_all();
+		for (auto & thread : m_threads)
+			thread.join();
+	}
+
+	void ThreadPool::Enqueue(std::function<void()> task)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_tasks.push_back(std::move(task));
+		}
+		m_condition.notify_one();
+	}
+
+	void ThreadPool::EnqueuePriority(std::function<void()> task)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_priorityTasks.push_back(std::move(task));
+		}
+		m_priorityCondition.notify_one();
+		m_condition.notify_one();
+	}
+
+	void ThreadPool::WorkerThread(bool priorityOnly)
+	{
+		while (true)
+		{
+			std::function<void()> task;
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				auto & condition = priorityOnly ? m_priorityCondition : m_condition;
+				condition.wait(lock, [this, priorityOnly]
+				{
+					return m_stopping || !m_priorityTasks.empty() || (!priorityOnly && !m_tasks.empty());
+				});
+				if (m_stopping)
+					return;
+				auto & tasks = m_priorityTasks.empty() ? m_tasks : m_priorityTasks;
+				task = std::move(tasks.front());
+				tasks.pop_front();
+			}
+			task();
+		}
+	}
+
+	ThreadPool & GetThreadPool()
+	{
+		if (!s_threadPool)
+			s_threadPool = std::make_unique<ThreadPool>();
+		return *s_threadPool;
+	}
+
+	void ShutDownThreadPool()
+	{
+		s_threadPool.reset();
+	}
+
+}
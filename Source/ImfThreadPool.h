@@ -0,0 +1,67 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2021 James Boer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#pragma once
+
+
+namespace ImFrame
+{
+
+	// Fixed-size pool of worker threads, running queued tasks in the order they were added.  Tasks
+	// that haven't started when the pool is destroyed are discarded, while running tasks are allowed
+	// to finish.
+	//
+	// Short tasks the user is waiting on, like saving settings or rebuilding fonts, go in a priority
+	// lane that every worker takes from first.  One extra worker only runs priority tasks, so they
+	// never wait behind a backlog of long ones.
+	class ThreadPool
+	{
+	public:
+		explicit ThreadPool(size_t threadCount = 0);
+		~ThreadPool();
+		ThreadPool(const ThreadPool &) = delete;
+		ThreadPool & operator = (const ThreadPool &) = delete;
+
+		void Enqueue(std::function<void()> task);
+		void EnqueuePriority(std::function<void()> task);
+		size_t GetThreadCount() const { return m_threads.size(); }
+
+	private:
+		void WorkerThread(bool priorityOnly);
+
+		std::vector<std::thread> m_threads;
+		std::deque<std::function<void()>> m_tasks;
+		std::deque<std::function<void()>> m_priorityTasks;
+		std::mutex m_mutex;
+		std::condition_variable m_condition;
+		std::condition_variable m_priorityCondition;
+		bool m_stopping = false;
+	};
+
+	// Pool shared by all background work, created on first use.  Shut down before releasing anything its
+	// tasks might still touch.
+	ThreadPool & GetThreadPool();
+	void ShutDownThreadPool();
+
+}
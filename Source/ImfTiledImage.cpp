@@ -0,0 +1,776 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2021 James Boer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include "ImfInternal.h"
+
+#include <imgui_internal.h>
+
+namespace ImFrame
+{
+
+	// Size of one pyramid level in pixels and tiles.  Tiles of all levels are numbered one after another, row by
+	// row, starting from the level's first tile.
+	struct TileLevel
+	{
+		int width = 0;
+		int height = 0;
+		int tilesX = 0;
+		int tilesY = 0;
+		size_t firstTile = 0;
+	};
+
+	// Image with its mip pyramid, each level half the size of the one before, down to a single tile.  A worker
+	// thread streams the image in rows, building every level at once, and writes each tile with its border to a
+	// temporary file, which the OS deletes once it's closed.  Only the coarsest tile stays in memory.  Others are
+	// read back by workers while they're in view, and released once uploaded.
+	struct TiledImage
+	{
+		uint32_t id = 0;
+		std::atomic<LoadState> state{ LoadState::Pending };
+
+		// Written by the worker before the state becomes complete, and read-only afterwards
+		std::vector<TileLevel> levels;
+		std::vector<uint8_t> coarsestTile;
+		std::unique_ptr<TempFile> tileFile;
+
+		// Tiles wanted in view, with the frame they were last wanted in, those read but not yet uploaded, and
+		// those that couldn't be read, which aren't asked for again
+		std::mutex tileMutex;
+		std::unordered_map<size_t, int> requestedTiles;
+		std::unordered_map<size_t, std::vector<uint8_t>> loadedTiles;
+		std::unordered_set<size_t> failedTiles;
+	};
+
+	namespace
+	{
+
+		// Atlas slots hold 254 pixels of tile content surrounded by a 1 pixel border copied from neighboring
+		// tiles, so bilinear filtering doesn't show seams between tiles
+		const int TileSlotSize = 256;
+		const int TileBorder = 1;
+		const int TileContentSize = TileSlotSize - TileBorder * 2;
+		const size_t TileBytes = static_cast<size_t>(TileSlotSize) * TileSlotSize * 4;
+		const int MaxAtlasSize = 4096;
+		const int MaxAtlasPages = 8;
+		const float MaxZoom = 32.0f;
+		const float ZoomStep = 1.2f;
+
+		struct AtlasSlot
+		{
+			uint64_t key = 0;
+			int lastUsedFrame = 0;
+			bool occupied = false;
+		};
+
+		// The atlas is split into pages of one texture each, added while every slot holds a tile drawn this
+		// frame.  One view at 4K can show around 600 tiles, more than a single 4096 texture holds.
+		struct TiledImageData
+		{
+			std::vector<GLuint> atlasPages;
+			int atlasSize = 0;
+			int slotsPerRow = 0;
+			int slotsPerPage = 0;
+			std::vector<AtlasSlot> slots;
+			std::unordered_map<uint64_t, int> residentTiles;
+			uint32_t nextImageId = 1;
+			int uploadFrame = -1;
+			size_t uploadedBytes = 0;
+		};
+
+		std::unique_ptr<TiledImageData> s_tiledImageData;
+
+		TiledImageData & GetTiledImageData()
+		{
+			if (!s_tiledImageData)
+				s_tiledImageData = std::make_unique<TiledImageData>();
+			return *s_tiledImageData;
+		}
+
+		uint64_t GetTileKey(uint32_t imageId, int level, int tileX, int tileY)
+		{
+			return (static_cast<uint64_t>(imageId) << 32) | (static_cast<uint64_t>(level) << 26) |
+				(static_cast<uint64_t>(tileY) << 13) | static_cast<uint64_t>(tileX);
+		}
+
+		int GetTileCount(int size)
+		{
+			return (size + TileContentSize - 1) / TileContentSize;
+		}
+
+		size_t GetTileIndex(const TiledImage & image, int level, int tileX, int tileY)
+		{
+			const TileLevel & tileLevel = image.levels[level];
+			return tileLevel.firstTile + static_cast<size_t>(tileY) * tileLevel.tilesX + tileX;
+		}
+
+		// Halves the size until the whole image fits in a single tile
+		std::vector<TileLevel> GetTileLevels(int width, int height)
+		{
+			std::vector<TileLevel> levels;
+			size_t firstTile = 0;
+			while (true)
+			{
+				TileLevel level;
+				level.width = width;
+				level.height = height;
+				level.tilesX = GetTileCount(width);
+				level.tilesY = GetTileCount(height);
+				level.firstTile = firstTile;
+				firstTile += static_cast<size_t>(level.tilesX) * level.tilesY;
+				levels.push_back(level);
+				if (width <= TileContentSize && height <= TileContentSize)
+					return levels;
+				width = std::max(1, width / 2);
+				height = std::max(1, height / 2);
+			}
+		}
+
+		// Lookup tables between sRGB and linear intensity
+		struct SrgbTables
+		{
+			static const int LinearSteps = 16384;
+
+			SrgbTables()
+			{
+				for (int i = 0; i < 256; ++i)
+				{
+					const float srgb = i / 255.0f;
+					toLinear[i] = srgb <= 0.04045f ? srgb / 12.92f : std::pow((srgb + 0.055f) / 1.055f, 2.4f);
+				}
+				for (int i = 0; i < LinearSteps; ++i)
+				{
+					const float linear = i / static_cast<float>(LinearSteps - 1);
+					const float srgb = linear <= 0.0031308f ? linear * 12.92f : 1.055f * std::pow(linear, 1.0f / 2.4f) - 0.055f;
+					toSrgb[i] = static_cast<uint8_t>(std::clamp(srgb * 255.0f + 0.5f, 0.0f, 255.0f));
+				}
+			}
+
+			uint8_t ToSrgb(float linear) const
+			{
+				return toSrgb[static_cast<int>(std::clamp(linear, 0.0f, 1.0f) * (LinearSteps - 1) + 0.5f)];
+			}
+
+			float toLinear[256];
+			uint8_t toSrgb[LinearSteps];
+		};
+
+		// Averages each 2x2 block of pixels from a pair of rows.  Like other mipmaps, this is gamma correct and
+		// alpha weighted.  An odd last column or row is dropped, and a single column or row is repeated.
+		void DownsampleRows(const uint8_t * top, const uint8_t * bottom, int width, int downsampledWidth, uint8_t * dest)
+		{
+			static const SrgbTables tables;
+			for (int x = 0; x < downsampledWidth; ++x)
+			{
+				const int left = std::min(x * 2, width - 1) * 4;
+				const int right = std::min(x * 2 + 1, width - 1) * 4;
+				const uint8_t * pixels[] = { top + left, top + right, bottom + left, bottom + right };
+				float color[3] = {};
+				float alpha = 0.0f;
+				for (const uint8_t * pixel : pixels)
+				{
+					const float weight = pixel[3] / 255.0f;
+					for (int c = 0; c < 3; ++c)
+						color[c] += tables.toLinear[pixel[c]] * weight;
+					alpha += weight;
+				}
+				uint8_t * destPixel = dest + x * 4;
+				for (int c = 0; c < 3; ++c)
+					destPixel[c] = alpha > 0.0f ? tables.ToSrgb(color[c] / alpha) : 0;
+				destPixel[3] = static_cast<uint8_t>(alpha * 0.25f * 255.0f + 0.5f);
+			}
+		}
+
+		// Rows of one level kept until every tile overlapping them, including borders, has been written
+		struct LevelRows
+		{
+			std::vector<uint8_t> rows;
+			int firstRow = 0;
+			int rowCount = 0;
+			int nextTileRow = 0;
+			std::vector<uint8_t> evenRow;
+			std::vector<uint8_t> downsampledRow;
+		};
+
+		struct PyramidBuilder
+		{
+			explicit PyramidBuilder(const std::vector<TileLevel> & levels) : levels(levels), levelRows(levels.size()), tile(TileBytes) {}
+			const std::vector<TileLevel> & levels;
+			std::vector<LevelRows> levelRows;
+			TempFile * file = nullptr;
+			std::vector<uint8_t> tile;
+			std::vector<uint8_t> coarsestTile;
+		};
+
+		// Copies a tile and its border out of the level's rows, repeating edge pixels beyond the image
+		void CopyTile(const TileLevel & level, const LevelRows & levelRows, int tileX, int tileY, uint8_t * tile)
+		{
+			const size_t rowSize = static_cast<size_t>(level.width) * 4;
+			for (int y = 0; y < TileSlotSize; ++y)
+			{
+				const int row = std::clamp(tileY * TileContentSize - TileBorder + y, 0, level.height - 1);
+				const uint8_t * source = levelRows.rows.data() + (row - levelRows.firstRow) * rowSize;
+				uint8_t * dest = tile + static_cast<size_t>(y) * TileSlotSize * 4;
+				for (int x = 0; x < TileSlotSize; ++x)
+				{
+					const int column = std::clamp(tileX * TileContentSize - TileBorder + x, 0, level.width - 1);
+					std::memcpy(dest + x * 4, source + column * 4, 4);
+				}
+			}
+		}
+
+		// Adds the next row of a level.  Each row of tiles is written as soon as its bottom border has arrived,
+		// and each pair of rows is averaged into a row of the next level, so every level is built in one pass.
+		bool AddRow(PyramidBuilder & builder, size_t level, const uint8_t * row)
+		{
+			const TileLevel & tileLevel = builder.levels[level];
+			LevelRows & levelRows = builder.levelRows[level];
+			const size_t rowSize = static_cast<size_t>(tileLevel.width) * 4;
+			levelRows.rows.insert(levelRows.rows.end(), row, row + rowSize);
+			const int rowIndex = levelRows.rowCount++;
+
+			const bool coarsest = level + 1 == builder.levels.size();
+			while (levelRows.nextTileRow < tileLevel.tilesY)
+			{
+				const int tileY = levelRows.nextTileRow;
+				if (levelRows.rowCount < std::min(tileLevel.height, (tileY + 1) * TileContentSize + TileBorder))
+					break;
+				for (int tileX = 0; tileX < tileLevel.tilesX; ++tileX)
+				{
+					CopyTile(tileLevel, levelRows, tileX, tileY, builder.tile.data());
+					if (coarsest)
+					{
+						builder.coarsestTile = builder.tile;
+						continue;
+					}
+					const size_t index = tileLevel.firstTile + static_cast<size_t>(tileY) * tileLevel.tilesX + tileX;
+					if (!builder.file->Write(index * TileBytes, builder.tile.data(), TileBytes))
+						return false;
+				}
+
+				// Drop rows above the next row of tiles' top border
+				++levelRows.nextTileRow;
+				const int firstRow = std::min(levelRows.rowCount, std::max(0, levelRows.nextTileRow * TileContentSize - TileBorder));
+				if (firstRow > levelRows.firstRow)
+				{
+					levelRows.rows.erase(levelRows.rows.begin(), levelRows.rows.begin() + (firstRow - levelRows.firstRow) * rowSize);
+					levelRows.firstRow = firstRow;
+				}
+			}
+			if (coarsest)
+				return true;
+
+			const TileLevel & nextLevel = builder.levels[level + 1];
+			const uint8_t * top = row;
+			if (tileLevel.height > 1)
+			{
+				if (rowIndex % 2 == 0)
+				{
+					levelRows.evenRow.assign(row, row + rowSize);
+					return true;
+				}
+				if (rowIndex / 2 >= nextLevel.height)
+					return true;
+				top = levelRows.evenRow.data();
+			}
+			levelRows.downsampledRow.resize(static_cast<size_t>(nextLevel.width) * 4);
+			DownsampleRows(top, row, tileLevel.width, nextLevel.width, levelRows.downsampledRow.data());
+			return AddRow(builder, level + 1, levelRows.downsampledRow.data());
+		}
+
+		// Streams the image through the pyramid builder in strips of rows.  Stops early if the worker holds the
+		// only handle left.
+		bool BuildTiles(const TiledImagePtr & image, int width, int height, const ImageRowReader & reader)
+		{
+			if (width <= 0 || height <= 0)
+				return false;
+			image->levels = GetTileLevels(width, height);
+			PyramidBuilder builder(image->levels);
+			if (image->levels.size() > 1)
+			{
+				image->tileFile = std::make_unique<TempFile>();
+				if (!image->tileFile->IsOpen())
+					return false;
+				builder.file = image->tileFile.get();
+			}
+
+			const size_t rowSize = static_cast<size_t>(width) * 4;
+			std::vector<uint8_t> strip(rowSize * TileContentSize);
+			for (int row = 0; row < height; row += TileContentSize)
+			{
+				if (image.use_count() == 1)
+					return false;
+				const int rowCount = std::min(TileContentSize, height - row);
+				if (!reader(row, rowCount, strip.data()))
+					return false;
+				for (int i = 0; i < rowCount; ++i)
+				{
+					if (!AddRow(builder, 0, strip.data() + i * rowSize))
+						return false;
+				}
+			}
+			image->coarsestTile = std::move(builder.coarsestTile);
+			return true;
+		}
+
+		// Rows are read straight out of an already decoded image
+		bool BuildTiles(const TiledImagePtr & image, const ImageInfo & source)
+		{
+			assert(source.channels == 4);
+			const size_t rowSize = static_cast<size_t>(source.width) * source.channels;
+			return BuildTiles(image, source.width, source.height, [&source, rowSize] (int firstRow, int rowCount, uint8_t * dest)
+			{
+				std::memcpy(dest, source.data.data() + firstRow * rowSize, rowCount * rowSize);
+				return true;
+			});
+		}
+
+		TiledImagePtr BuildTiledImage(std::function<bool(const TiledImagePtr &)> build)
+		{
+			auto image = std::make_shared<TiledImage>();
+			image->id = GetTiledImageData().nextImageId++;
+			std::weak_ptr<TiledImage> weakImage = image;
+			GetThreadPool().Enqueue([weakImage, build = std::move(build)] ()
+			{
+				// Skip loading if the handle was released while still queued
+				auto image = weakImage.lock();
+				if (!image)
+					return;
+				image->state = build(image) ? LoadState::Complete : LoadState::Failed;
+				RequestRedraw();
+			});
+			return image;
+		}
+
+		// Reads a tile on a worker thread, unless it went out of view while queued.  Tiles that can't be read
+		// are marked as failed, so they aren't asked for again.
+		void RequestTile(const TiledImagePtr & image, size_t index)
+		{
+			std::weak_ptr<TiledImage> weakImage = image;
+			GetThreadPool().Enqueue([weakImage, index] ()
+			{
+				auto image = weakImage.lock();
+				if (!image)
+					return;
+				{
+					std::lock_guard<std::mutex> lock(image->tileMutex);
+					if (!image->requestedTiles.count(index))
+						return;
+				}
+				std::vector<uint8_t> tile(TileBytes);
+				const bool read = image->tileFile->Read(index * TileBytes, tile.data(), TileBytes);
+				{
+					std::lock_guard<std::mutex> lock(image->tileMutex);
+					if (!read)
+					{
+						image->requestedTiles.erase(index);
+						image->failedTiles.insert(index);
+						return;
+					}
+					if (image->requestedTiles.count(index))
+						image->loadedTiles[index] = std::move(tile);
+				}
+				RequestRedraw();
+			});
+		}
+
+		// Forgets tiles that weren't wanted this frame, whether still being read or waiting to be uploaded
+		void ReleaseUnwantedTiles(TiledImage & image)
+		{
+			const int frame = ImGui::GetFrameCount();
+			std::lock_guard<std::mutex> lock(image.tileMutex);
+			for (auto it = image.requestedTiles.begin(); it != image.requestedTiles.end();)
+			{
+				if (it->second < frame)
+				{
+					image.loadedTiles.erase(it->first);
+					it = image.requestedTiles.erase(it);
+				}
+				else
+					++it;
+			}
+		}
+
+		// Adds an atlas texture, along with its slots
+		bool AddAtlasPage()
+		{
+			auto & data = GetTiledImageData();
+			if (data.atlasPages.empty())
+			{
+				GLint maxTextureSize = 0;
+				glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTextureSize);
+				data.atlasSize = std::min(MaxAtlasSize, static_cast<int>(maxTextureSize)) / TileSlotSize * TileSlotSize;
+				data.slotsPerRow = data.atlasSize / TileSlotSize;
+				data.slotsPerPage = data.slotsPerRow * data.slotsPerRow;
+			}
+			else if (static_cast<int>(data.atlasPages.size()) >= MaxAtlasPages)
+				return false;
+			GLuint texture = 0;
+			glGenTextures(1, &texture);
+			glBindTexture(GL_TEXTURE_2D, texture);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, data.atlasSize, data.atlasSize, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+			ImGui_ImplOpenGL3_InvalidateStateCache();
+			data.atlasPages.push_back(texture);
+			data.slots.resize(data.atlasPages.size() * data.slotsPerPage);
+			return true;
+		}
+
+		// Claims a free slot, or the least recently drawn one.  Slots drawn this frame are never reused, so
+		// another page is added when they're all in view, and returns -1 once there are no more pages.
+		int AcquireSlot(uint64_t key, int frame)
+		{
+			auto & data = *s_tiledImageData;
+			int best = -1;
+			for (int i = 0; i < static_cast<int>(data.slots.size()); ++i)
+			{
+				const auto & slot = data.slots[i];
+				if (!slot.occupied)
+				{
+					best = i;
+					break;
+				}
+				if (slot.lastUsedFrame < frame && (best < 0 || slot.lastUsedFrame < data.slots[best].lastUsedFrame))
+					best = i;
+			}
+			if (best < 0)
+			{
+				const int firstNewSlot = static_cast<int>(data.slots.size());
+				if (!AddAtlasPage())
+					return -1;
+				best = firstNewSlot;
+			}
+			auto & slot = data.slots[best];
+			if (slot.occupied)
+				data.residentTiles.erase(slot.key);
+			slot.key = key;
+			slot.lastUsedFrame = frame;
+			slot.occupied = true;
+			data.residentTiles[key] = best;
+			return best;
+		}
+
+		// Position of a slot within its page's texture
+		ImVec2 GetSlotPosition(int slot)
+		{
+			const auto & data = *s_tiledImageData;
+			const int pageSlot = slot % data.slotsPerPage;
+			return ImVec2(static_cast<float>((pageSlot % data.slotsPerRow) * TileSlotSize), static_cast<float>((pageSlot / data.slotsPerRow) * TileSlotSize));
+		}
+
+		// Tiles are stored with their borders, so fill the whole slot
+		void UploadTile(const uint8_t * tile, int slot)
+		{
+			auto & data = *s_tiledImageData;
+			const ImVec2 position = GetSlotPosition(slot);
+			glBindTexture(GL_TEXTURE_2D, data.atlasPages[slot / data.slotsPerPage]);
+#if defined(GL_UNPACK_ROW_LENGTH) && !defined(__EMSCRIPTEN__)
+			glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+#endif
+			glTexSubImage2D(GL_TEXTURE_2D, 0, static_cast<GLint>(position.x), static_cast<GLint>(position.y),
+				TileSlotSize, TileSlotSize, GL_RGBA, GL_UNSIGNED_BYTE, tile);
+			ImGui_ImplOpenGL3_InvalidateStateCache();
+			data.uploadedBytes += TileBytes;
+		}
+
+		// Returns the atlas slot holding a tile, uploading it if allowed and the atlas has room.  Tiles other
+		// than the coarsest are requested from the tile file first, and kept wanted while asked for each frame.
+		// A read tile stays loaded until it gets a slot.  Sets pending if the tile should arrive in a later
+		// frame, but not if it failed to read or the atlas is full of visible tiles.
+		int FindTile(const TiledImagePtr & image, int level, int tileX, int tileY, bool upload, bool & pending)
+		{
+			auto & data = *s_tiledImageData;
+			const int frame = ImGui::GetFrameCount();
+			const uint64_t key = GetTileKey(image->id, level, tileX, tileY);
+			pending = false;
+			auto it = data.residentTiles.find(key);
+			if (it != data.residentTiles.end())
+			{
+				data.slots[it->second].lastUsedFrame = frame;
+				return it->second;
+			}
+
+			if (level + 1 == static_cast<int>(image->levels.size()))
+			{
+				const int slot = upload ? AcquireSlot(key, frame) : -1;
+				if (slot >= 0)
+					UploadTile(image->coarsestTile.data(), slot);
+				return slot;
+			}
+
+			const size_t index = GetTileIndex(*image, level, tileX, tileY);
+			std::vector<uint8_t> tile;
+			{
+				std::lock_guard<std::mutex> lock(image->tileMutex);
+				if (image->failedTiles.count(index))
+					return -1;
+				pending = true;
+				auto request = image->requestedTiles.find(index);
+				if (request == image->requestedTiles.end())
+				{
+					if (upload)
+					{
+						image->requestedTiles[index] = frame;
+						RequestTile(image, index);
+					}
+					return -1;
+				}
+				request->second = frame;
+				auto loaded = image->loadedTiles.find(index);
+				if (!upload || loaded == image->loadedTiles.end())
+					return -1;
+				pending = false;
+				if (AcquireSlot(key, frame) < 0)
+					return -1;
+				tile = std::move(loaded->second);
+				image->loadedTiles.erase(loaded);
+				image->requestedTiles.erase(request);
+			}
+			const int slot = data.residentTiles[key];
+			UploadTile(tile.data(), slot);
+			return slot;
+		}
+
+		struct ViewTransform
+		{
+			ImVec2 origin;		// Screen position of the image's top left corner
+			float zoom;			// Screen pixels per image pixel
+		};
+
+		// Draws one tile of the given level, falling back to the nearest coarser level that's resident while
+		// it streams in.  Returns true if the requested tile is still to come in a later frame.
+		bool DrawTile(ImDrawList * drawList, const TiledImagePtr & image, const ViewTransform & view, int level, int tileX, int tileY)
+		{
+			auto & data = *s_tiledImageData;
+			const TileLevel & base = image->levels.front();
+			const TileLevel & tileLevel = image->levels[level];
+
+			// Tile bounds in full resolution pixels
+			const float scaleX = static_cast<float>(base.width) / tileLevel.width;
+			const float scaleY = static_cast<float>(base.height) / tileLevel.height;
+			const float minX = tileX * TileContentSize * scaleX;
+			const float minY = tileY * TileContentSize * scaleY;
+			const float maxX = std::min(tileLevel.width, (tileX + 1) * TileContentSize) * scaleX;
+			const float maxY = std::min(tileLevel.height, (tileY + 1) * TileContentSize) * scaleY;
+
+			// Upload within this frame's budget, where zero means no limit, but always allow the coarsest level
+			// so there's something to show
+			if (data.uploadFrame != ImGui::GetFrameCount())
+			{
+				data.uploadFrame = ImGui::GetFrameCount();
+				data.uploadedBytes = 0;
+			}
+			const size_t budget = GetTextureUploadBudget();
+			const int coarsestLevel = static_cast<int>(image->levels.size()) - 1;
+			bool tilePending = false;
+			for (int sourceLevel = level; sourceLevel <= coarsestLevel; ++sourceLevel)
+			{
+				const TileLevel & source = image->levels[sourceLevel];
+				const float sourceScaleX = static_cast<float>(base.width) / source.width;
+				const float sourceScaleY = static_cast<float>(base.height) / source.height;
+				const int sourceTileX = std::min(static_cast<int>((minX + maxX) * 0.5f / sourceScaleX) / TileContentSize, source.tilesX - 1);
+				const int sourceTileY = std::min(static_cast<int>((minY + maxY) * 0.5f / sourceScaleY) / TileContentSize, source.tilesY - 1);
+				const bool upload = sourceLevel == coarsestLevel || (sourceLevel == level && (budget == 0 || data.uploadedBytes < budget));
+				bool pending = false;
+				const int slot = FindTile(image, sourceLevel, sourceTileX, sourceTileY, upload, pending);
+				if (sourceLevel == level)
+					tilePending = pending;
+				if (slot < 0)
+					continue;
+
+				// Map the tile bounds into the source tile's content within its atlas page
+				const ImVec2 position = GetSlotPosition(slot);
+				const float slotX = position.x + TileBorder - sourceTileX * TileContentSize;
+				const float slotY = position.y + TileBorder - sourceTileY * TileContentSize;
+				const float atlasScale = 1.0f / data.atlasSize;
+				const ImVec2 uvMin((slotX + minX / sourceScaleX) * atlasScale, (slotY + minY / sourceScaleY) * atlasScale);
+				const ImVec2 uvMax((slotX + maxX / sourceScaleX) * atlasScale, (slotY + maxY / sourceScaleY) * atlasScale);
+				drawList->AddImage(reinterpret_cast<ImTextureID>(static_cast<intptr_t>(data.atlasPages[slot / data.slotsPerPage])),
+					ImVec2(view.origin.x + minX * view.zoom, view.origin.y + minY * view.zoom),
+					ImVec2(view.origin.x + maxX * view.zoom, view.origin.y + maxY * view.zoom), uvMin, uvMax);
+				break;
+			}
+			return tilePending;
+		}
+
+	}
+
+	void ShutDownTiledImages()
+	{
+		if (!s_tiledImageData)
+			return;
+		if (!s_tiledImageData->atlasPages.empty())
+			glDeleteTextures(static_cast<GLsizei>(s_tiledImageData->atlasPages.size()), s_tiledImageData->atlasPages.data());
+		s_tiledImageData.reset();
+	}
+
+	// Decodes the image on a worker thread, then streams it into tiles.  stb_image has to decode the whole image
+	// at once, and is limited to 2 GB of decoded pixels, so use CreateTiledImage() with a row reader beyond that.
+	TiledImagePtr LoadTiledImage(const char * filename)
+	{
+		return BuildTiledImage([path = std::string(filename)] (const TiledImagePtr & image)
+		{
+			auto source = LoadImage(path.c_str());
+			return source && BuildTiles(image, source.value());
+		});
+	}
+
+	// Builds the pyramid for an already decoded RGBA image on a worker thread
+	TiledImagePtr CreateTiledImage(ImageInfo && image)
+	{
+		assert(image.channels == 4);
+		auto source = std::make_shared<ImageInfo>(std::move(image));
+		return BuildTiledImage([source] (const TiledImagePtr & image)
+		{
+			const bool built = BuildTiles(image, *source);
+			*source = ImageInfo();
+			return built;
+		});
+	}
+
+	// Builds the pyramid on a worker thread, reading the image a strip of rows at a time
+	TiledImagePtr CreateTiledImage(int width, int height, ImageRowReader reader)
+	{
+		return BuildTiledImage([width, height, reader = std::move(reader)] (const TiledImagePtr & image)
+		{
+			return BuildTiles(image, width, height, reader);
+		});
+	}
+
+	LoadState GetTiledImageState(const TiledImagePtr & image)
+	{
+		assert(image);
+		return image->state;
+	}
+
+	bool ImageView(const char * label, const TiledImagePtr & image, const ImVec2 & size)
+	{
+		ImGui::PushID(label);
+		ImGuiStorage * storage = ImGui::GetStateStorage();
+		const ImGuiID zoomId = ImGui::GetID("zoom");
+		const ImGuiID centerXId = ImGui::GetID("centerX");
+		const ImGuiID centerYId = ImGui::GetID("centerY");
+
+		// Zero or negative sizes fill the remaining content region, like other ImGui widgets
+		const ImVec2 available = ImGui::GetContentRegionAvail();
+		const ImVec2 viewSize(std::max(1.0f, size.x > 0.0f ? size.x : available.x), std::max(1.0f, size.y > 0.0f ? size.y : available.y));
+		const ImVec2 viewMin = ImGui::GetCursorScreenPos();
+		const ImVec2 viewMax(viewMin.x + viewSize.x, viewMin.y + viewSize.y);
+		ImGui::InvisibleButton("##view", viewSize, ImGuiButtonFlags_MouseButtonLeft | ImGuiButtonFlags_MouseButtonMiddle);
+		ImGui::SetItemUsingMouseWheel();
+		const bool hovered = ImGui::IsItemHovered();
+		const bool active = ImGui::IsItemActive();
+		ImDrawList * drawList = ImGui::GetWindowDrawList();
+		drawList->AddRectFilled(viewMin, viewMax, ImGui::GetColorU32(ImGuiCol_FrameBg));
+
+		if (!image || image->state != LoadState::Complete)
+		{
+			const char * text = image && image->state == LoadState::Failed ? "Failed to load image" : "Loading...";
+			const ImVec2 textSize = ImGui::CalcTextSize(text);
+			drawList->AddText(ImVec2(viewMin.x + (viewSize.x - textSize.x) * 0.5f, viewMin.y + (viewSize.y - textSize.y) * 0.5f),
+				ImGui::GetColorU32(ImGuiCol_TextDisabled), text);
+			ImGui::PopID();
+			return false;
+		}
+
+		// Fit the image to the view initially and on double-click
+		const TileLevel & base = image->levels.front();
+		const float fitZoom = std::min(viewSize.x / base.width, viewSize.y / base.height);
+		float zoom = storage->GetFloat(zoomId, 0.0f);
+		ImVec2 center(storage->GetFloat(centerXId), storage->GetFloat(centerYId));
+		bool changed = false;
+		if (zoom <= 0.0f || (hovered && ImGui::IsMouseDoubleClicked(ImGuiMouseButton_Left)))
+		{
+			zoom = fitZoom;
+			center = ImVec2(base.width * 0.5f, base.height * 0.5f);
+			changed = true;
+		}
+
+		// Drag to pan, and zoom around the point under the mouse cursor
+		const ImGuiIO & io = ImGui::GetIO();
+		if (active && (io.MouseDelta.x != 0.0f || io.MouseDelta.y != 0.0f))
+		{
+			center.x -= io.MouseDelta.x / zoom;
+			center.y -= io.MouseDelta.y / zoom;
+			changed = true;
+		}
+		if (hovered && io.MouseWheel != 0.0f)
+		{
+			const ImVec2 mouse(io.MousePos.x - viewMin.x - viewSize.x * 0.5f, io.MousePos.y - viewMin.y - viewSize.y * 0.5f);
+			const float newZoom = std::clamp(zoom * std::pow(ZoomStep, io.MouseWheel), fitZoom * 0.5f, MaxZoom);
+			center.x += mouse.x / zoom - mouse.x / newZoom;
+			center.y += mouse.y / zoom - mouse.y / newZoom;
+			zoom = newZoom;
+			changed = true;
+		}
+		storage->SetFloat(zoomId, zoom);
+		storage->SetFloat(centerXId, center.x);
+		storage->SetFloat(centerYId, center.y);
+
+		// Use the finest level with at least one texel per screen pixel
+		const int coarsestLevel = static_cast<int>(image->levels.size()) - 1;
+		const int level = zoom >= 1.0f ? 0 : std::min(coarsestLevel, static_cast<int>(std::floor(std::log2(1.0f / zoom))));
+		const TileLevel & levelImage = image->levels[level];
+		const float scaleX = static_cast<float>(base.width) / levelImage.width;
+		const float scaleY = static_cast<float>(base.height) / levelImage.height;
+
+		// Draw only tiles overlapping the view
+		ViewTransform view;
+		view.zoom = zoom;
+		view.origin = ImVec2(viewMin.x + viewSize.x * 0.5f - center.x * zoom, viewMin.y + viewSize.y * 0.5f - center.y * zoom);
+		const float visibleMinX = (viewMin.x - view.origin.x) / zoom / scaleX;
+		const float visibleMinY = (viewMin.y - view.origin.y) / zoom / scaleY;
+		const float visibleMaxX = (viewMax.x - view.origin.x) / zoom / scaleX;
+		const float visibleMaxY = (viewMax.y - view.origin.y) / zoom / scaleY;
+		const int firstTileX = std::max(0, static_cast<int>(std::floor(visibleMinX / TileContentSize)));
+		const int firstTileY = std::max(0, static_cast<int>(std::floor(visibleMinY / TileContentSize)));
+		const int lastTileX = std::min(levelImage.tilesX - 1, static_cast<int>(std::floor(visibleMaxX / TileContentSize)));
+		const int lastTileY = std::min(levelImage.tilesY - 1, static_cast<int>(std::floor(visibleMaxY / TileContentSize)));
+
+		if (GetTiledImageData().atlasPages.empty())
+			AddAtlasPage();
+		drawList->PushClipRect(viewMin, viewMax, true);
+		bool pendingTiles = false;
+		for (int tileY = firstTileY; tileY <= lastTileY; ++tileY)
+		{
+			for (int tileX = firstTileX; tileX <= lastTileX; ++tileX)
+			{
+				if (DrawTile(drawList, image, view, level, tileX, tileY))
+					pendingTiles = true;
+			}
+		}
+		drawList->PopClipRect();
+		ReleaseUnwantedTiles(*image);
+
+		// Keep frames coming until every visible tile has streamed in, or can't be shown
+		if (pendingTiles)
+			RequestRedraw();
+
+		ImGui::PopID();
+		return changed;
+	}
+
+}
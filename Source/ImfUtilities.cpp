@@ -57,4 +57,54 @@ namespace ImFrame
 		return OsGetNativeWindow(window);
 	}
 
+	MappedFile::MappedFile(const std::filesystem::path & path)
+	{
+		m_data = OsMapFile(path, m_size);
+	}
+
+	MappedFile::~MappedFile()
+	{
+		if (m_data)
+			OsUnmapFile(m_data, m_size);
+	}
+
+	MappedFile::MappedFile(MappedFile && other) noexcept :
+		m_data(std::exchange(other.m_data, nullptr)),
+		m_size(std::exchange(other.m_size, 0))
+	{
+	}
+
+	MappedFile & MappedFile::operator = (MappedFile && other) noexcept
+	{
+		if (this != &other)
+		{
+			if (m_data)
+				OsUnmapFile(m_data, m_size);
+			m_data = std::exchange(other.m_data, nullptr);
+			m_size = std::exchange(other.m_size, 0);
+		}
+		return *this;
+	}
+
+	TempFile::TempFile() :
+		m_file(OsCreateTempFile())
+	{
+	}
+
+	TempFile::~TempFile()
+	{
+		if (IsOpen())
+			OsCloseFile(m_file);
+	}
+
+	bool TempFile::Write(uint64_t offset, const void * data, size_t size)
+	{
+		return IsOpen() && OsWriteFile(m_file, offset, data, size);
+	}
+
+	bool TempFile::Read(uint64_t offset, void * data, size_t size) const
+	{
+		return IsOpen() && OsReadFile(m_file, offset, data, size);
+	}
+
 }
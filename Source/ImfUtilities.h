@@ -32,4 +32,42 @@ namespace ImFrame
 	std::filesystem::path GetExecutableFolder();
 	std::filesystem::path GetResourceFolder();
 	void * GetNativeWindow(GLFWwindow * window);
+
+	// Read-only view of a whole file, memory mapped so only the parts actually read are loaded from disk.
+	// Empty if the file couldn't be opened or has no contents.
+	class MappedFile
+	{
+	public:
+		MappedFile() = default;
+		explicit MappedFile(const std::filesystem::path & path);
+		~MappedFile();
+		MappedFile(MappedFile && other) noexcept;
+		MappedFile & operator = (MappedFile && other) noexcept;
+
+		const char * GetData() const { return static_cast<const char *>(m_data); }
+		size_t GetSize() const { return m_size; }
+		bool IsEmpty() const { return m_size == 0; }
+
+	private:
+		const void * m_data = nullptr;
+		size_t m_size = 0;
+	};
+
+	// Scratch file in the temp folder with no name, so the OS deletes it once closed, even if the process is
+	// killed.  Reads and writes take an offset rather than seeking, so threads can share the file.
+	class TempFile
+	{
+	public:
+		TempFile();
+		~TempFile();
+		TempFile(const TempFile &) = delete;
+		TempFile & operator = (const TempFile &) = delete;
+
+		bool IsOpen() const { return m_file != -1; }
+		bool Write(uint64_t offset, const void * data, size_t size);
+		bool Read(uint64_t offset, void * data, size_t size) const;
+
+	private:
+		intptr_t m_file = -1;
+	};
 }
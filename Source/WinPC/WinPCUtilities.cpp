@@ -100,6 +100,95 @@ namespace ImFrame
 		return static_cast<void *>(glfwGetWin32Window(window));
 	}
 
+	const void * OsMapFile(const std::filesystem::path & path, size_t & size)
+	{
+		size = 0;
+		HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+		if (file == INVALID_HANDLE_VALUE)
+			return nullptr;
+		const void * data = nullptr;
+		LARGE_INTEGER fileSize;
+		if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0)
+		{
+			HANDLE mapping = CreateFileMappingW(file, NULL, PAGE_READONLY, 0, 0, NULL);
+			if (mapping)
+			{
+				data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+				if (data)
+					size = static_cast<size_t>(fileSize.QuadPart);
+				CloseHandle(mapping);
+			}
+		}
+		CloseHandle(file);
+		return data;
+	}
+
+	void OsUnmapFile(const void * data, [[maybe_unused]] size_t size)
+	{
+		UnmapViewOfFile(data);
+	}
+
+	// Deleted on close by the OS, and marked temporary so it's kept in the cache rather than written out where
+	// possible
+	intptr_t OsCreateTempFile()
+	{
+		wchar_t folder[MAX_PATH + 1];
+		wchar_t path[MAX_PATH + 1];
+		if (!GetTempPathW(MAX_PATH + 1, folder) || !GetTempFileNameW(folder, L"Imf", 0, path))
+			return -1;
+		HANDLE file = CreateFileW(path, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL,
+			CREATE_ALWAYS, FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_DELETE_ON_CLOSE, NULL);
+		if (file == INVALID_HANDLE_VALUE)
+		{
+			DeleteFileW(path);
+			return -1;
+		}
+		return reinterpret_cast<intptr_t>(file);
+	}
+
+	void OsCloseFile(intptr_t file)
+	{
+		CloseHandle(reinterpret_cast<HANDLE>(file));
+	}
+
+	bool OsWriteFile(intptr_t file, uint64_t offset, const void * data, size_t size)
+	{
+		auto bytes = static_cast<const char *>(data);
+		while (size > 0)
+		{
+			OVERLAPPED overlapped = {};
+			overlapped.Offset = static_cast<DWORD>(offset);
+			overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+			DWORD written = 0;
+			const DWORD count = static_cast<DWORD>(std::min<size_t>(size, 1u << 30));
+			if (!WriteFile(reinterpret_cast<HANDLE>(file), bytes, count, &written, &overlapped) || written == 0)
+				return false;
+			bytes += written;
+			offset += written;
+			size -= written;
+		}
+		return true;
+	}
+
+	bool OsReadFile(intptr_t file, uint64_t offset, void * data, size_t size)
+	{
+		auto bytes = static_cast<char *>(data);
+		while (size > 0)
+		{
+			OVERLAPPED overlapped = {};
+			overlapped.Offset = static_cast<DWORD>(offset);
+			overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+			DWORD read = 0;
+			const DWORD count = static_cast<DWORD>(std::min<size_t>(size, 1u << 30));
+			if (!ReadFile(reinterpret_cast<HANDLE>(file), bytes, count, &read, &overlapped) || read == 0)
+				return false;
+			bytes += read;
+			offset += read;
+			size -= read;
+		}
+		return true;
+	}
+
     void OsInitialize()
     {
     }
@@ -32,6 +32,11 @@ THE SOFTWARE.
 #import <Foundation/Foundation.h>
 #import <Cocoa/Cocoa.h>
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 namespace ImFrame
 {
     static NSInteger s_selectedTagId = -1;
@@ -96,6 +101,84 @@ namespace ImFrame
         return static_cast<void *>(glfwGetCocoaWindow(window));
     }
 
+    const void * OsMapFile(const std::filesystem::path & path, size_t & size)
+    {
+        size = 0;
+        int file = open(path.c_str(), O_RDONLY);
+        if (file < 0)
+            return nullptr;
+        void * data = nullptr;
+        struct stat info;
+        if (fstat(file, &info) == 0 && info.st_size > 0)
+        {
+            data = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+            if (data == MAP_FAILED)
+                data = nullptr;
+            else
+                size = static_cast<size_t>(info.st_size);
+        }
+        close(file);
+        return data;
+    }
+
+    void OsUnmapFile(const void * data, size_t size)
+    {
+        munmap(const_cast<void *>(data), size);
+    }
+
+    // Unnamed where the file system supports it, otherwise unlinked as soon as it's created
+    intptr_t OsCreateTempFile()
+    {
+        const std::string folder = std::filesystem::temp_directory_path().string();
+        int file = -1;
+#ifdef O_TMPFILE
+        file = open(folder.c_str(), O_TMPFILE | O_RDWR | O_EXCL | O_CLOEXEC, S_IRUSR | S_IWUSR);
+        if (file >= 0)
+            return file;
+#endif
+        std::string path = folder + "/ImFrameXXXXXX";
+        file = mkstemp(path.data());
+        if (file < 0)
+            return -1;
+        unlink(path.c_str());
+        return file;
+    }
+
+    void OsCloseFile(intptr_t file)
+    {
+        close(static_cast<int>(file));
+    }
+
+    bool OsWriteFile(intptr_t file, uint64_t offset, const void * data, size_t size)
+    {
+        auto bytes = static_cast<const char *>(data);
+        while (size > 0)
+        {
+            const ssize_t written = pwrite(static_cast<int>(file), bytes, size, static_cast<off_t>(offset));
+            if (written <= 0)
+                return false;
+            bytes += written;
+            offset += static_cast<uint64_t>(written);
+            size -= static_cast<size_t>(written);
+        }
+        return true;
+    }
+
+    bool OsReadFile(intptr_t file, uint64_t offset, void * data, size_t size)
+    {
+        auto bytes = static_cast<char *>(data);
+        while (size > 0)
+        {
+            const ssize_t read = pread(static_cast<int>(file), bytes, size, static_cast<off_t>(offset));
+            if (read <= 0)
+                return false;
+            bytes += read;
+            offset += static_cast<uint64_t>(read);
+            size -= static_cast<size_t>(read);
+        }
+        return true;
+    }
+
     void OsInitialize()
     {
         s_menuHandler = [[MenuItemHandler new] autorelease];
@@ -0,0 +1,205 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2021 James Boer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include <Tbl.hpp>
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Times the ways Tbl has parsed numeric cells: strtoll and istringstream on copies, std::from_chars, and the
+// single pass Tbl::Detail::ParseNumber() used now.  Inputs are generated, so runs are repeatable anywhere.
+
+namespace
+{
+
+	using Format = Tbl::Detail::Format;
+
+	// Cells are views into one buffer, as they are into a table's text
+	struct Input
+	{
+		const char * name;
+		Format format;
+		std::string text;
+		std::vector<std::string_view> cells;
+	};
+
+	template<typename MakeCell>
+	Input MakeInput(const char * name, Format format, size_t cellCount, MakeCell makeCell)
+	{
+		Input input{ name, format, {}, {} };
+		std::mt19937 random(12345);
+		std::vector<size_t> ends;
+		char cell[64];
+		for (size_t i = 0; i < cellCount; ++i)
+		{
+			input.text.append(cell, makeCell(random, cell, sizeof(cell)));
+			ends.push_back(input.text.size());
+		}
+		size_t start = 0;
+		for (size_t end : ends)
+		{
+			input.cells.emplace_back(input.text.data() + start, end - start);
+			start = end;
+		}
+		return input;
+	}
+
+	// The original parsing: strtoll on a terminated copy, then istringstream on another copy with any continental
+	// decimal commas replaced
+	bool ParseStream(std::string_view str, Format format, double & value)
+	{
+		const std::string s(str);
+		char * end = nullptr;
+		const long long intValue = strtoll(s.c_str(), &end, 10);
+		if (end == s.c_str() + s.size())
+		{
+			value = static_cast<double>(intValue);
+			return true;
+		}
+		std::string copy(str);
+		if (format == Format::Continental)
+			std::replace(copy.begin(), copy.end(), ',', '.');
+		std::istringstream stream(copy);
+		stream.imbue(std::locale::classic());
+		stream >> value;
+		return !stream.fail();
+	}
+
+#ifdef __cpp_lib_to_chars
+	// The same with std::from_chars, which only needs a copy to replace continental decimal commas
+	bool ParseFromChars(std::string_view str, Format format, double & value)
+	{
+		int64_t intValue = 0;
+		auto result = std::from_chars(str.data(), str.data() + str.size(), intValue);
+		if (result.ec == std::errc() && result.ptr == str.data() + str.size())
+		{
+			value = static_cast<double>(intValue);
+			return true;
+		}
+		if (format == Format::Continental)
+		{
+			std::string copy(str);
+			std::replace(copy.begin(), copy.end(), ',', '.');
+			result = std::from_chars(copy.data(), copy.data() + copy.size(), value);
+			return result.ec == std::errc() && result.ptr == copy.data() + copy.size();
+		}
+		result = std::from_chars(str.data(), str.data() + str.size(), value);
+		return result.ec == std::errc() && result.ptr == str.data() + str.size();
+	}
+#endif
+
+	bool ParseNumber(std::string_view str, Format format, double & value)
+	{
+		int64_t intValue = 0;
+		const size_t type = Tbl::Detail::ParseNumber(str, format, intValue, value);
+		if (type == Tbl::IntType)
+			value = static_cast<double>(intValue);
+		return type != Tbl::StringType;
+	}
+
+	// Best of several runs, in nanoseconds per cell.  The sum of parsed values is checked against the other
+	// methods, and keeps the work from being optimized away.
+	template<typename Parse>
+	double Time(const Input & input, Parse parse, double & sum)
+	{
+		const int runs = 5;
+		double best = std::numeric_limits<double>::max();
+		for (int run = 0; run < runs; ++run)
+		{
+			const auto start = std::chrono::steady_clock::now();
+			sum = 0.0;
+			for (std::string_view cell : input.cells)
+			{
+				double value = 0.0;
+				if (parse(cell, input.format, value))
+					sum += value;
+			}
+			const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+			best = std::min(best, elapsed.count());
+		}
+		return best / static_cast<double>(input.cells.size());
+	}
+
+}
+
+int main(int argc, char ** argv)
+{
+	const size_t cellCount = argc > 1 ? strtoull(argv[1], nullptr, 10) : 1000000;
+	if (argc > 2 || cellCount == 0)
+	{
+		printf("Usage: TableBenchmark [cells]\n");
+		printf("Times parsing each kind of numeric cell, %d by default.\n", 1000000);
+		return 1;
+	}
+
+	std::vector<Input> inputs;
+	inputs.push_back(MakeInput("Integers", Format::International, cellCount, [] (std::mt19937 & random, char * cell, size_t size)
+	{
+		return static_cast<size_t>(snprintf(cell, size, "%d", static_cast<int>(random() % 200000) - 100000));
+	}));
+	inputs.push_back(MakeInput("Floats", Format::International, cellCount, [] (std::mt19937 & random, char * cell, size_t size)
+	{
+		return static_cast<size_t>(snprintf(cell, size, "%.6f", std::uniform_real_distribution<double>(-1000.0, 1000.0)(random)));
+	}));
+	inputs.push_back(MakeInput("Continental", Format::Continental, cellCount, [] (std::mt19937 & random, char * cell, size_t size)
+	{
+		const auto length = static_cast<size_t>(snprintf(cell, size, "%.4f", std::uniform_real_distribution<double>(0.0, 10000.0)(random)));
+		std::replace(cell, cell + length, '.', ',');
+		return length;
+	}));
+
+	printf("%zu cells each, ns per cell, best of 5 runs\n", cellCount);
+	printf("%-12s %14s %14s %14s\n", "Input", "istringstream", "from_chars", "ParseNumber");
+	bool matched = true;
+	for (const auto & input : inputs)
+	{
+		double streamSum = 0.0;
+		double numberSum = 0.0;
+		const double stream = Time(input, ParseStream, streamSum);
+		const double number = Time(input, ParseNumber, numberSum);
+		matched = matched && streamSum == numberSum;
+#ifdef __cpp_lib_to_chars
+		double fromCharsSum = 0.0;
+		const double fromChars = Time(input, ParseFromChars, fromCharsSum);
+		matched = matched && fromCharsSum == numberSum;
+		printf("%-12s %14.1f %14.1f %14.1f\n", input.name, stream, fromChars, number);
+#else
+		printf("%-12s %14.1f %14s %14.1f\n", input.name, stream, "n/a", number);
+#endif
+	}
+	if (!matched)
+	{
+		fprintf(stderr, "Error: parsing methods disagree\n");
+		return 1;
+	}
+	return 0;
+}
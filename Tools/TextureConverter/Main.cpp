@@ -0,0 +1,129 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2021 James Boer
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include "ImfTextureCodec.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include <stb_image.h>
+#include <stb_image_resize.h>
+
+// Converts PNG, JPG or other stb_image formats to BC1 or BC3 compressed DDS files, for use with
+// ImFrame::LoadCompressedTexture().
+
+namespace
+{
+
+	void PrintUsage()
+	{
+		printf("Usage: TextureConverter [options] input output.dds\n");
+		printf("  -bc1     Compress to BC1 (4 bits per pixel, no alpha)\n");
+		printf("  -bc3     Compress to BC3 (8 bits per pixel, with alpha)\n");
+		printf("  -nomips  Store only the base level\n");
+		printf("By default, opaque images use BC1, others use BC3, and a full mip chain is stored.\n");
+	}
+
+	bool IsOpaque(const uint8_t * pixels, size_t pixelCount)
+	{
+		for (size_t i = 0; i < pixelCount; ++i)
+		{
+			if (pixels[i * 4 + 3] != 255)
+				return false;
+		}
+		return true;
+	}
+
+}
+
+int main(int argc, char ** argv)
+{
+	const char * input = nullptr;
+	const char * output = nullptr;
+	std::string format;
+	bool mips = true;
+	for (int i = 1; i < argc; ++i)
+	{
+		if (strcmp(argv[i], "-bc1") == 0 || strcmp(argv[i], "-bc3") == 0)
+			format = argv[i];
+		else if (strcmp(argv[i], "-nomips") == 0)
+			mips = false;
+		else if (!input)
+			input = argv[i];
+		else if (!output)
+			output = argv[i];
+		else
+		{
+			PrintUsage();
+			return 1;
+		}
+	}
+	if (!input || !output)
+	{
+		PrintUsage();
+		return 1;
+	}
+
+	int width = 0;
+	int height = 0;
+	uint8_t * pixels = stbi_load(input, &width, &height, NULL, 4);
+	if (!pixels)
+	{
+		fprintf(stderr, "Error: unable to load %s (%s)\n", input, stbi_failure_reason());
+		return 1;
+	}
+
+	ImFrame::CompressedImage image;
+	if (format.empty())
+		image.format = IsOpaque(pixels, static_cast<size_t>(width) * height) ? ImFrame::BlockFormat::BC1 : ImFrame::BlockFormat::BC3;
+	else
+		image.format = format == "-bc1" ? ImFrame::BlockFormat::BC1 : ImFrame::BlockFormat::BC3;
+
+	// Each mip is downsampled from the level above, gamma correct and alpha weighted, matching ImFrame's CPU mipmaps
+	std::vector<uint8_t> level(pixels, pixels + static_cast<size_t>(width) * height * 4);
+	stbi_image_free(pixels);
+	while (true)
+	{
+		image.levels.push_back({ width, height, ImFrame::EncodeBlocks(image.format, level.data(), width, height) });
+		if (!mips || (width == 1 && height == 1))
+			break;
+		const int mipWidth = std::max(1, width / 2);
+		const int mipHeight = std::max(1, height / 2);
+		std::vector<uint8_t> mip(static_cast<size_t>(mipWidth) * mipHeight * 4);
+		stbir_resize_uint8_srgb(level.data(), width, height, 0, mip.data(), mipWidth, mipHeight, 0, 4, 3, 0);
+		level = std::move(mip);
+		width = mipWidth;
+		height = mipHeight;
+	}
+
+	if (!ImFrame::SaveCompressedImage(output, image))
+	{
+		fprintf(stderr, "Error: unable to write %s\n", output);
+		return 1;
+	}
+	printf("Wrote %s: %s, %zu levels\n", output, image.format == ImFrame::BlockFormat::BC1 ? "BC1" : "BC3", image.levels.size());
+	return 0;
+}